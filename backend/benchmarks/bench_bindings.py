@@ -0,0 +1,107 @@
+"""
+Benchmark the pybind11 boundary of traider_cpp.
+
+Measures the fixed per-call overhead (scalar calls, engine methods) and the
+list <-> std::vector conversion cost as the input grows. Each py.<case> times
+the full Python call; subtract the matching bench_native <case> at the same
+size for the boundary cost. Output uses the same JSON schema as bench_native
+so both can be compared against one baseline.
+
+Usage:
+    python bench_bindings.py [--max-size N] [--output FILE]
+
+Run from backend/ (or with backend/ on PYTHONPATH) so traider_cpp is importable.
+"""
+import argparse
+import json
+import os
+import random
+import sys
+import time
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+
+import traider_cpp  # noqa: E402
+
+
+def timeit(fn, min_time=0.25, max_reps=50):
+    fn()  # warm-up
+    samples = []
+    total = 0.0
+    while len(samples) < max_reps:
+        start = time.perf_counter_ns()
+        fn()
+        ns = time.perf_counter_ns() - start
+        samples.append(ns)
+        total += ns
+        if total >= min_time * 1e9 and len(samples) >= 3:
+            break
+        if ns >= min_time * 1e9:
+            break
+    samples.sort()
+    return len(samples), samples[len(samples) // 2], samples[0]
+
+
+def random_walk(n, seed=42):
+    rng = random.Random(seed)
+    p = 100.0
+    out = []
+    for _ in range(n):
+        p = max(1.0, p * (1.0 + rng.gauss(0.0, 0.01)))
+        out.append(p)
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--max-size", type=int, default=1_000_000)
+    parser.add_argument("--min-time", type=float, default=0.25)
+    parser.add_argument("--output", "-o")
+    args = parser.parse_args()
+
+    results = []
+
+    def record(name, size, symbols, items, fn):
+        iterations, median_ns, min_ns = timeit(fn, args.min_time)
+        results.append({
+            "name": name, "size": size, "symbols": symbols, "iterations": iterations,
+            "median_ns": median_ns, "min_ns": min_ns, "ns_per_item": median_ns / max(items, 1),
+        })
+        print(f"{name:<40} size={size:<10} {median_ns / max(items, 1):12.1f} ns/item", file=sys.stderr)
+
+    # Fixed call overhead: a scalar function, batched so the timer resolution does not dominate.
+    calls = 10_000
+    pct_change = traider_cpp.utils.pct_change
+    record("py.call.pct_change", 1, 1, calls, lambda: [pct_change(101.0, 100.0) for _ in range(calls)])
+
+    engine = traider_cpp.core.TradingEngine(1e12)
+    engine.execute_trade("BENCH", 10.0, 100.0, traider_cpp.core.OrderSide.BUY)
+    record("py.call.update_price", 1, 1, calls,
+           lambda: [engine.update_price("BENCH", 101.0) for _ in range(calls)])
+    record("py.call.get_positions", 1, 1, calls, lambda: [engine.get_positions() for _ in range(calls)])
+
+    # Conversion cost: list -> std::vector in, std::vector -> list out.
+    size = 1000
+    while size <= args.max_size:
+        prices = random_walk(size)
+        signals = [1 if i % 100 == 0 else (-1 if i % 100 == 50 else 0) for i in range(size)]
+        record("py.utils.mean", size, 1, size, lambda: traider_cpp.utils.mean(prices))
+        record("py.indicators.sma", size, 1, size, lambda: traider_cpp.indicators.sma(prices, 20))
+        record("py.indicators.bollinger_bands", size, 1, size,
+               lambda: traider_cpp.indicators.bollinger_bands(prices, 20, 2.0))
+        record("py.backtesting.calculate_metrics", size, 1, size,
+               lambda: traider_cpp.backtesting.calculate_metrics(prices, 0.02))
+        record("py.backtesting.run_simple", size, 1, size,
+               lambda: traider_cpp.backtesting.BacktestEngine(100000.0).run_simple("BENCH", prices, signals))
+        size *= 10
+
+    doc = json.dumps({"suite": "python", "results": results}, indent=2) + "\n"
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(doc)
+    else:
+        sys.stdout.write(doc)
+
+
+if __name__ == "__main__":
+    main()
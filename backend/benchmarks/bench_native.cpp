@@ -0,0 +1,368 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "indicators/technical_indicators.h"
+#include "data/data_processor.h"
+#include "data/bar_codec.h"
+#include "portfolio/portfolio_analytics.h"
+#include "core/trading_engine.h"
+#include "backtesting/backtest_engine.h"
+#include "pricing/black_scholes.h"
+#include "pricing/lattice.h"
+
+// Native micro-benchmarks for the traider_cpp core.
+//
+// Every case is timed over a range of input sizes (bars) or symbol counts and
+// reported as JSON so that compare_baseline.py can diff a run against the
+// stored baseline. See README.md in this directory for usage.
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        long long max_bars = 1000000;
+        long long max_symbols = 5000;
+        double min_time = 0.25; // seconds spent per case before stopping
+        int max_reps = 50;
+        std::string filter;
+        std::string output;
+    };
+
+    struct CaseResult {
+        std::string name;
+        long long size;
+        long long symbols;
+        int iterations;
+        double median_ns;
+        double min_ns;
+        double ns_per_item;
+    };
+
+    // Keeps the optimizer from discarding benchmark results.
+    volatile double g_sink = 0.0;
+
+    template <typename T>
+    void consume(const std::vector<T>& v) {
+        if (!v.empty()) g_sink = g_sink + static_cast<double>(v.back()) + v.size();
+    }
+
+    void consume(double v) { g_sink = g_sink + v; }
+
+    std::vector<double> random_walk(size_t n, unsigned seed) {
+        std::mt19937_64 rng(seed);
+        std::normal_distribution<double> step(0.0, 0.01);
+        std::vector<double> prices(n);
+        double p = 100.0;
+        for (size_t i = 0; i < n; ++i) {
+            p *= 1.0 + step(rng);
+            if (p < 1.0) p = 1.0;
+            prices[i] = p;
+        }
+        return prices;
+    }
+
+    std::vector<double> random_volumes(size_t n, unsigned seed) {
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<double> dist(1e3, 1e6);
+        std::vector<double> volumes(n);
+        for (auto& v : volumes) v = dist(rng);
+        return volumes;
+    }
+
+    std::vector<int> periodic_signals(size_t n, size_t every) {
+        std::vector<int> signals(n, 0);
+        for (size_t i = 0; i < n; i += every) {
+            signals[i] = ((i / every) % 2 == 0) ? 1 : -1;
+        }
+        return signals;
+    }
+
+    std::vector<long long> sizes_up_to(long long max_value, long long start) {
+        std::vector<long long> sizes;
+        for (long long s = start; s <= max_value; s *= 10) sizes.push_back(s);
+        return sizes;
+    }
+
+    class Runner {
+    public:
+        explicit Runner(const Options& opts) : opts_(opts) {}
+
+        // Time `body` repeatedly; `items` is the number of logical elements
+        // processed per invocation (bars, trades, ...), used for ns/item.
+        void run(const std::string& name, long long size, long long symbols, long long items,
+                 const std::function<void()>& body) {
+            if (!opts_.filter.empty() && name.find(opts_.filter) == std::string::npos) return;
+
+            body(); // warm-up
+
+            std::vector<double> samples;
+            double total = 0.0;
+            while (samples.size() < static_cast<size_t>(opts_.max_reps)) {
+                auto start = Clock::now();
+                body();
+                double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+                samples.push_back(ns);
+                total += ns;
+                if (total >= opts_.min_time * 1e9 && samples.size() >= 3) break;
+                if (ns >= opts_.min_time * 1e9) break; // large inputs: one sample is enough
+            }
+
+            std::sort(samples.begin(), samples.end());
+            CaseResult r;
+            r.name = name;
+            r.size = size;
+            r.symbols = symbols;
+            r.iterations = static_cast<int>(samples.size());
+            r.median_ns = samples[samples.size() / 2];
+            r.min_ns = samples.front();
+            r.ns_per_item = items > 0 ? r.median_ns / items : r.median_ns;
+            results_.push_back(r);
+
+            std::fprintf(stderr, "%-40s size=%-10lld symbols=%-6lld %12.1f ns/item\n",
+                         name.c_str(), size, symbols, r.ns_per_item);
+        }
+
+        std::string to_json() const {
+            std::ostringstream out;
+            out.precision(17);
+            out << "{\n  \"suite\": \"native\",\n  \"results\": [\n";
+            for (size_t i = 0; i < results_.size(); ++i) {
+                const auto& r = results_[i];
+                out << "    {\"name\": \"" << r.name << "\", \"size\": " << r.size
+                    << ", \"symbols\": " << r.symbols << ", \"iterations\": " << r.iterations
+                    << ", \"median_ns\": " << r.median_ns << ", \"min_ns\": " << r.min_ns
+                    << ", \"ns_per_item\": " << r.ns_per_item << "}"
+                    << (i + 1 < results_.size() ? ",\n" : "\n");
+            }
+            out << "  ]\n}\n";
+            return out.str();
+        }
+
+    private:
+        const Options& opts_;
+        std::vector<CaseResult> results_;
+    };
+
+    void bench_series(Runner& runner, const Options& opts) {
+        using namespace traider;
+
+        for (long long n : sizes_up_to(opts.max_bars, 1000)) {
+            auto prices = random_walk(static_cast<size_t>(n), 42);
+            auto volumes = random_volumes(static_cast<size_t>(n), 7);
+
+            runner.run("indicators.sma", n, 1, n, [&] { consume(indicators::sma(prices, 20)); });
+            runner.run("indicators.ema", n, 1, n, [&] { consume(indicators::ema(prices, 20)); });
+            runner.run("indicators.rsi", n, 1, n, [&] { consume(indicators::rsi(prices, 14)); });
+            runner.run("indicators.vwap", n, 1, n, [&] { consume(indicators::vwap(prices, volumes)); });
+            runner.run("indicators.bollinger_bands", n, 1, n, [&] {
+                consume(indicators::bollinger_bands(prices, 20, 2.0).first);
+            });
+
+            std::vector<long long> timestamps(static_cast<size_t>(n));
+            for (long long i = 0; i < n; ++i) timestamps[static_cast<size_t>(i)] = 1600000000LL + i * 60;
+
+            runner.run("data.align_data", n, 1, n, [&] {
+                consume(data::DataProcessor::align_data(prices, volumes, timestamps).size() * 1.0);
+            });
+            auto bars = data::DataProcessor::align_data(prices, volumes, timestamps);
+            runner.run("data.resample", n, 1, n, [&] {
+                consume(data::DataProcessor::resample(bars, 60).size() * 1.0);
+            });
+            runner.run("data.bar_codec.encode", n, 1, n, [&] {
+                consume(data::CompressedBarSeries::encode(bars).compressed_bytes() * 1.0);
+            });
+            auto compressed = data::CompressedBarSeries::encode(bars);
+            runner.run("data.bar_codec.decode", n, 1, n, [&] {
+                consume(compressed.decode().size() * 1.0);
+            });
+            runner.run("data.bar_codec.select_close_above", n, 1, n, [&] {
+                consume(compressed.select_close_above(prices[static_cast<size_t>(n) / 2]).size() * 1.0);
+            });
+            bars.clear();
+            bars.shrink_to_fit();
+            runner.run("data.normalize", n, 1, n, [&] { consume(data::DataProcessor::normalize(prices)); });
+
+            // As-of join of 8 series with staggered calendars covering n rows in total
+            std::vector<std::vector<long long>> series_ts(8);
+            std::vector<std::vector<double>> series_vals(8);
+            for (long long i = 0; i < n; ++i) {
+                size_t s = static_cast<size_t>(i % 8);
+                series_ts[s].push_back(timestamps[static_cast<size_t>(i)] + static_cast<long long>(s) * 7);
+                series_vals[s].push_back(prices[static_cast<size_t>(i)]);
+            }
+            runner.run("data.align_asof", n, 8, n, [&] {
+                consume(data::DataProcessor::align_asof(series_ts, series_vals, {}, true, 600).values);
+            });
+
+            runner.run("portfolio.calculate_metrics", n, 1, n, [&] {
+                consume(portfolio::PortfolioAnalytics::calculate_metrics(prices).sharpe_ratio);
+            });
+            runner.run("portfolio.calculate_max_drawdown", n, 1, n, [&] {
+                consume(portfolio::PortfolioAnalytics::calculate_max_drawdown(prices));
+            });
+            runner.run("portfolio.calculate_sharpe_ratio", n, 1, n, [&] {
+                consume(portfolio::PortfolioAnalytics::calculate_sharpe_ratio(prices, 0.0));
+            });
+
+            auto signals = periodic_signals(static_cast<size_t>(n), 50);
+            runner.run("backtesting.run_simple", n, 1, n, [&] {
+                backtesting::BacktestEngine engine(100000.0);
+                consume(engine.run_simple("BENCH", prices, signals).equity_curve);
+            });
+
+            backtesting::BacktestEngine reuse_engine(100000.0);
+            backtesting::BacktestWorkspace workspace;
+            runner.run("backtesting.run_simple_into", n, 1, n, [&] {
+                reuse_engine.run_simple_into(prices, signals, workspace);
+                consume(workspace.equity_curve());
+            });
+
+            std::vector<std::vector<int>> signal_sets;
+            for (size_t period = 20; period < 20 + 8 * 10; period += 10) {
+                signal_sets.push_back(periodic_signals(static_cast<size_t>(n), period));
+            }
+            long long sweep_items = n * static_cast<long long>(signal_sets.size());
+            runner.run("backtesting.run_simple_sweep", n, 1, sweep_items, [&] {
+                consume(reuse_engine.run_simple_sweep(prices, signal_sets).back().total_return);
+            });
+        }
+    }
+
+    void bench_engine(Runner& runner, const Options& opts) {
+        using namespace traider;
+
+        std::vector<long long> symbol_counts;
+        for (long long s : {1LL, 10LL, 100LL, 1000LL, 5000LL}) {
+            if (s <= opts.max_symbols) symbol_counts.push_back(s);
+        }
+
+        for (long long symbols : symbol_counts) {
+            std::vector<std::string> tickers;
+            tickers.reserve(static_cast<size_t>(symbols));
+            for (long long i = 0; i < symbols; ++i) tickers.push_back("SYM" + std::to_string(i));
+            auto prices = random_walk(static_cast<size_t>(symbols), 99);
+
+            // One buy and one full sell per symbol: exercises insert, average-price
+            // update, realized PnL and position erase.
+            runner.run("core.execute_trade", 1, symbols, symbols * 2, [&] {
+                core::TradingEngine engine(1e12);
+                for (size_t i = 0; i < tickers.size(); ++i) {
+                    engine.execute_trade(tickers[i], 10.0, prices[i], core::OrderSide::BUY);
+                }
+                for (size_t i = 0; i < tickers.size(); ++i) {
+                    engine.execute_trade(tickers[i], 10.0, prices[i], core::OrderSide::SELL);
+                }
+                consume(engine.get_capital());
+            });
+
+            core::TradingEngine held(1e12);
+            for (size_t i = 0; i < tickers.size(); ++i) {
+                held.execute_trade(tickers[i], 10.0, prices[i], core::OrderSide::BUY);
+            }
+            runner.run("core.update_price", 1, symbols, symbols, [&] {
+                for (size_t i = 0; i < tickers.size(); ++i) {
+                    held.update_price(tickers[i], prices[i] * 1.001);
+                }
+                consume(held.get_portfolio_value());
+            });
+        }
+    }
+
+    void bench_pricing(Runner& runner, const Options& opts) {
+        using namespace traider;
+
+        // Option chains are far smaller than bar series; cap at 1e6 contracts
+        for (long long n : sizes_up_to(std::min(opts.max_bars, 1000000LL), 1000)) {
+            size_t count = static_cast<size_t>(n);
+            std::vector<double> spots(count), strikes(count), times(count), vols(count);
+            std::vector<int> is_call(count);
+            for (size_t i = 0; i < count; ++i) {
+                spots[i] = 50.0 + static_cast<double>(i % 300);
+                strikes[i] = spots[i] * (0.7 + 0.01 * static_cast<double>(i % 60));
+                times[i] = 0.02 + 0.05 * static_cast<double>(i % 40);
+                vols[i] = 0.1 + 0.005 * static_cast<double>(i % 100);
+                is_call[i] = static_cast<int>(i % 2);
+            }
+            auto prices = pricing::bsm_price_batch(spots, strikes, times, vols, is_call, 0.03);
+
+            runner.run("pricing.bsm_greeks_batch", n, 1, n, [&] {
+                consume(pricing::bsm_greeks_batch(spots, strikes, times, vols, is_call, 0.03).delta);
+            });
+            runner.run("pricing.implied_volatility_batch", n, 1, n, [&] {
+                consume(pricing::implied_volatility_batch(prices, spots, strikes, times, is_call, 0.03));
+            });
+            if (n <= 10000) { // O(steps^2) per contract
+                runner.run("pricing.american_price_batch", n, 1, n, [&] {
+                    consume(pricing::american_price_batch(spots, strikes, times, vols, is_call, 0.03, {},
+                                                          pricing::LatticeModel::BINOMIAL, 100));
+                });
+            }
+        }
+    }
+
+    bool parse_args(int argc, char** argv, Options& opts) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto next = [&]() -> const char* {
+                if (i + 1 >= argc) {
+                    std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+                    std::exit(2);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--full") {
+                opts.max_bars = 100000000;
+            } else if (arg == "--max-bars") {
+                opts.max_bars = std::atoll(next());
+            } else if (arg == "--max-symbols") {
+                opts.max_symbols = std::atoll(next());
+            } else if (arg == "--min-time") {
+                opts.min_time = std::atof(next());
+            } else if (arg == "--max-reps") {
+                opts.max_reps = std::max(1, std::atoi(next()));
+            } else if (arg == "--filter") {
+                opts.filter = next();
+            } else if (arg == "--output" || arg == "-o") {
+                opts.output = next();
+            } else {
+                std::fprintf(stderr,
+                    "usage: %s [--full] [--max-bars N] [--max-symbols N] [--min-time SEC]\n"
+                    "          [--max-reps N] [--filter SUBSTR] [--output FILE]\n", argv[0]);
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opts;
+    if (!parse_args(argc, argv, opts)) return 2;
+
+    Runner runner(opts);
+    bench_series(runner, opts);
+    bench_engine(runner, opts);
+    bench_pricing(runner, opts);
+
+    std::string json = runner.to_json();
+    if (opts.output.empty()) {
+        std::cout << json;
+    } else {
+        std::ofstream out(opts.output);
+        out << json;
+    }
+    return 0;
+}
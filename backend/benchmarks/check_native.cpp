@@ -0,0 +1,321 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/fixed_point.h"
+#include "core/fixed_trading_engine.h"
+#include "backtesting/backtest_engine.h"
+#include "data/bar_codec.h"
+
+// Native invariant checks for the traider_cpp core.
+//
+// Not a benchmark: each check asserts a property the optimized code paths must
+// keep (exact round-trips, equivalence with the reference implementation,
+// overflow rejection). Run with `make check`; exits non-zero on any failure.
+
+namespace {
+
+    int g_failures = 0;
+
+#define CHECK(cond)                                                                  \
+    do {                                                                             \
+        if (!(cond)) {                                                               \
+            std::fprintf(stderr, "  FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+            ++g_failures;                                                            \
+        }                                                                            \
+    } while (0)
+
+    template <typename Exception, typename Fn>
+    bool throws(Fn&& fn) {
+        try {
+            fn();
+        } catch (const Exception&) {
+            return true;
+        } catch (...) {
+            return false;
+        }
+        return false;
+    }
+
+    // --- Fixed point ---
+
+    void check_fixed_point_conversions() {
+        using traider::core::FixedPointConfig;
+        FixedPointConfig config;
+
+        CHECK(config.price_to_ticks(101.2345) == 1012345);
+        CHECK(config.cash_to_units(1e14) == 1000000000000000000LL);
+
+        // Out of int64 range or non-finite: rejected instead of wrapping through llround
+        CHECK(throws<std::out_of_range>([&] { config.cash_to_units(1e15); }));
+        CHECK(throws<std::out_of_range>([&] { config.price_to_ticks(-1e15); }));
+        CHECK(throws<std::invalid_argument>([&] { config.price_to_ticks(std::nan("")); }));
+        CHECK(throws<std::invalid_argument>([&] {
+            config.quantity_to_units(std::numeric_limits<double>::infinity());
+        }));
+
+        CHECK(throws<std::invalid_argument>([] { FixedPointConfig(0, 1, 1); }));
+        CHECK(throws<std::invalid_argument>([] { FixedPointConfig(10000, -1, 1); }));
+        CHECK(throws<std::invalid_argument>([] { FixedPointConfig(10000, 1, 0); }));
+    }
+
+    void check_fixed_point_overflow() {
+        using namespace traider::core;
+        const int64_t max = std::numeric_limits<int64_t>::max();
+
+        // quantity * price overflows int64: rejected, book untouched
+        FixedTradingEngine engine(max / 2);
+        CHECK(!engine.execute_trade("X", int64_t{1} << 40, int64_t{1} << 40, OrderSide::BUY));
+        CHECK(engine.get_cash() == max / 2);
+        CHECK(engine.get_positions().empty());
+
+        // A mark that pushes the valuation past int64 saturates instead of wrapping
+        FixedTradingEngine marked(int64_t{1} << 20);
+        CHECK(marked.execute_trade("X", int64_t{1} << 20, 1, OrderSide::BUY));
+        marked.update_price("X", int64_t{1} << 50);
+        CHECK(marked.get_portfolio_value() == max);
+
+        // Exact integer P&L: buy and sell at different ticks, no rounding residue
+        FixedTradingEngine exact(1000000);
+        CHECK(exact.execute_trade("X", 3, 1001, OrderSide::BUY));
+        CHECK(exact.execute_trade("X", 3, 1002, OrderSide::SELL));
+        CHECK(exact.get_cash() == 1000003);
+        CHECK(exact.get_positions().empty());
+
+        // Starting balance beyond int64 at the default scale
+        traider::backtesting::BacktestEngine backtest(1e15);
+        CHECK(throws<std::out_of_range>([&] { backtest.run_simple_fixed("X", {1.0, 2.0}, {1, -1}); }));
+    }
+
+    // --- Backtest workspace ---
+
+    std::vector<double> wavy_prices(size_t n) {
+        std::vector<double> prices(n);
+        double price = 100.0;
+        for (size_t i = 0; i < n; ++i) {
+            price *= 1.0 + 0.01 * std::sin(static_cast<double>(i) * 0.7);
+            prices[i] = price;
+        }
+        return prices;
+    }
+
+    std::vector<int> periodic_signals(size_t n, size_t period) {
+        std::vector<int> signals(n, 0);
+        for (size_t i = 0; i < n; ++i) {
+            if (i % period == 0) signals[i] = 1;
+            else if (i % period == period / 2) signals[i] = -1;
+        }
+        return signals;
+    }
+
+    bool same_value(double a, double b) { return a == b || (std::isnan(a) && std::isnan(b)); }
+
+    bool same_metrics(const traider::portfolio::PortfolioMetrics& a, const traider::portfolio::PortfolioMetrics& b) {
+        return same_value(a.total_return, b.total_return) && same_value(a.sharpe_ratio, b.sharpe_ratio) &&
+               same_value(a.sortino_ratio, b.sortino_ratio) && same_value(a.max_drawdown, b.max_drawdown) &&
+               same_value(a.volatility, b.volatility);
+    }
+
+    void check_run_simple_into_matches_run_simple() {
+        using namespace traider::backtesting;
+        auto prices = wavy_prices(3000);
+        BacktestEngine reuse(100000.0);
+        BacktestWorkspace workspace;
+
+        for (size_t period : {7, 37, 200}) {
+            auto signals = periodic_signals(prices.size(), period);
+            BacktestEngine fresh(100000.0);
+            BacktestResult expected = fresh.run_simple("X", prices, signals);
+            CHECK(reuse.run_simple_into(prices, signals, workspace));
+
+            // The flat book mirrors TradingEngine step for step, so results are bit-identical
+            CHECK(workspace.equity_curve() == expected.equity_curve);
+            CHECK(same_metrics(workspace.metrics(), expected.metrics));
+            CHECK(workspace.trades().size() == expected.trades.size());
+            for (size_t i = 0; i < std::min(workspace.trades().size(), expected.trades.size()); ++i) {
+                CHECK(workspace.trades()[i].side == expected.trades[i].side);
+                CHECK(workspace.trades()[i].quantity == expected.trades[i].quantity);
+                CHECK(workspace.trades()[i].price == expected.trades[i].price);
+            }
+        }
+
+        CHECK(!reuse.run_simple_into(prices, {1, -1}, workspace));
+        CHECK(workspace.equity_curve().empty());
+    }
+
+    void check_sweep_matches_run_simple() {
+        using namespace traider::backtesting;
+        auto prices = wavy_prices(2000);
+        std::vector<std::vector<int>> signal_sets;
+        for (size_t period = 20; period < 120; period += 10) {
+            signal_sets.push_back(periodic_signals(prices.size(), period));
+        }
+
+        BacktestEngine engine(100000.0);
+        traider::utils::WorkerPool workers(4);
+        std::vector<BacktestWorkspace> workspaces;
+        auto pooled = engine.run_simple_sweep(prices, signal_sets, workspaces, workers);
+        auto shared = engine.run_simple_sweep(prices, signal_sets);
+        CHECK(pooled.size() == signal_sets.size());
+        CHECK(shared.size() == signal_sets.size());
+        for (size_t i = 0; i < signal_sets.size() && i < pooled.size() && i < shared.size(); ++i) {
+            BacktestEngine fresh(100000.0);
+            auto expected = fresh.run_simple("X", prices, signal_sets[i]).metrics;
+            CHECK(same_metrics(pooled[i], expected));
+            CHECK(same_metrics(shared[i], expected));
+        }
+
+        // Warmed-up workspaces do not grow again on repeated sweeps of the same shape
+        size_t growth = 0;
+        for (const auto& w : workspaces) growth += w.growth_count();
+        for (int rep = 0; rep < 5; ++rep) engine.run_simple_sweep(prices, signal_sets, workspaces, workers);
+        size_t regrowth = 0;
+        for (const auto& w : workspaces) regrowth += w.growth_count();
+        CHECK(regrowth == growth);
+    }
+
+    // --- Bar codec ---
+
+    // Bars on the 4-decimal price grid with irregular timestamps (gaps and repeats),
+    // so a 4-decimal encoding must round-trip them exactly
+    std::vector<traider::data::OHLCV> grid_bars(size_t n) {
+        std::vector<traider::data::OHLCV> bars(n);
+        long long ts = 1700000000;
+        int64_t close = 1500000; // 150.0000
+        for (size_t i = 0; i < n; ++i) {
+            ts += i % 97 == 0 ? 3600 : (i % 13 == 0 ? 0 : 60);
+            close += static_cast<int64_t>((i * 7919) % 401) - 200;
+            auto& bar = bars[i];
+            bar.timestamp = ts;
+            bar.close = close / 1e4;
+            bar.open = (close + static_cast<int64_t>(i % 31) - 15) / 1e4;
+            bar.high = (close + static_cast<int64_t>(i % 23) + 20) / 1e4;
+            bar.low = (close - static_cast<int64_t>(i % 19) - 20) / 1e4;
+            bar.volume = static_cast<double>((i * 104729) % 5000000);
+        }
+        return bars;
+    }
+
+    bool same_bars(const std::vector<traider::data::OHLCV>& a, const std::vector<traider::data::OHLCV>& b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].timestamp != b[i].timestamp || a[i].open != b[i].open || a[i].high != b[i].high ||
+                a[i].low != b[i].low || a[i].close != b[i].close || a[i].volume != b[i].volume) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void check_bar_codec_round_trip() {
+        using traider::data::CompressedBarSeries;
+        using traider::data::OHLCV;
+        auto bars = grid_bars(5000); // Not a multiple of the block size: leaves a raw tail
+        auto series = CompressedBarSeries::encode(bars, 4, 0, 512);
+        CHECK(series.size() == bars.size());
+        CHECK(series.num_blocks() == bars.size() / 512);
+        CHECK(same_bars(series.decode(), bars));
+
+        // Range and predicate queries agree with filtering the full decode, across block edges
+        long long start = bars[700].timestamp, end = bars[2600].timestamp;
+        std::vector<OHLCV> in_range, above;
+        double threshold = bars[1234].close;
+        for (const auto& bar : bars) {
+            if (bar.timestamp >= start && bar.timestamp <= end) in_range.push_back(bar);
+            if (bar.close > threshold) above.push_back(bar);
+        }
+        CHECK(same_bars(series.decode_range(start, end), in_range));
+        CHECK(same_bars(series.select_close_above(threshold), above));
+
+        std::vector<long long> timestamps;
+        std::vector<double> closes;
+        series.decode_closes(start, end, timestamps, closes);
+        CHECK(timestamps.size() == in_range.size() && closes.size() == in_range.size());
+        for (size_t i = 0; i < std::min(timestamps.size(), in_range.size()); ++i) {
+            CHECK(timestamps[i] == in_range[i].timestamp);
+            CHECK(closes[i] == in_range[i].close);
+        }
+
+        // Summaries describe exactly the bars in their block
+        for (size_t b = 0; b < series.num_blocks(); ++b) {
+            const auto& summary = series.block_summary(b);
+            double volume = 0.0, min_low = bars[b * 512].low, max_close = bars[b * 512].close;
+            for (size_t i = b * 512; i < (b + 1) * 512; ++i) {
+                volume += bars[i].volume;
+                min_low = std::min(min_low, bars[i].low);
+                max_close = std::max(max_close, bars[i].close);
+            }
+            CHECK(summary.count == 512);
+            CHECK(summary.first_timestamp == bars[b * 512].timestamp);
+            CHECK(summary.total_volume == volume);
+            CHECK(summary.min_low == min_low);
+            CHECK(summary.max_close == max_close);
+        }
+        CHECK(throws<std::out_of_range>([&] { series.block_summary(series.num_blocks()); }));
+    }
+
+    void check_bar_codec_rejects_bad_input() {
+        using traider::data::CompressedBarSeries;
+        using traider::data::OHLCV;
+        CHECK(throws<std::invalid_argument>([] { CompressedBarSeries(4, 0, CompressedBarSeries::kMaxBlockSize + 1); }));
+
+        CompressedBarSeries series(4, 0, 16);
+        OHLCV bar{1.0, 1.0, 1.0, 1.0, 10.0, 100};
+        CHECK(series.append(bar));
+        OHLCV earlier = bar;
+        earlier.timestamp = 99;
+        CHECK(!series.append(earlier));
+        OHLCV nan_close = bar;
+        nan_close.close = std::nan("");
+        CHECK(!series.append(nan_close));
+        OHLCV huge = bar;
+        huge.high = 1e12; // 1e16 at 4 decimals, beyond the exact 2^51 range
+        CHECK(!series.append(huge));
+        CHECK(series.size() == 1);
+
+        // A full block at the largest accepted volume sums without overflowing
+        CompressedBarSeries wide(4, 0, CompressedBarSeries::kMaxBlockSize);
+        std::vector<OHLCV> bars(CompressedBarSeries::kMaxBlockSize, bar);
+        for (size_t i = 0; i < bars.size(); ++i) {
+            bars[i].timestamp = static_cast<long long>(i);
+            bars[i].volume = 2251799813685247.0; // 2^51 - 1
+        }
+        CHECK(wide.append(bars) == bars.size());
+        CHECK(wide.num_blocks() == 1 && wide.block_summary(0).total_volume > 9.2e18);
+    }
+
+    struct Check {
+        const char* name;
+        void (*fn)();
+    };
+
+    const Check kChecks[] = {
+        {"fixed_point.conversions", check_fixed_point_conversions},
+        {"fixed_point.overflow", check_fixed_point_overflow},
+        {"backtest.run_simple_into", check_run_simple_into_matches_run_simple},
+        {"backtest.run_simple_sweep", check_sweep_matches_run_simple},
+        {"bar_codec.round_trip", check_bar_codec_round_trip},
+        {"bar_codec.bad_input", check_bar_codec_rejects_bad_input},
+    };
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    int run = 0;
+    for (const Check& check : kChecks) {
+        if (filter && std::strstr(check.name, filter) == nullptr) continue;
+        int before = g_failures;
+        check.fn();
+        std::fprintf(stderr, "%-40s %s\n", check.name, g_failures == before ? "ok" : "FAILED");
+        ++run;
+    }
+    std::fprintf(stderr, "%d check(s), %d failure(s)\n", run, g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+"""
+Compare benchmark JSON output against a stored baseline.
+
+Usage:
+    python compare_baseline.py baseline.json build/native.json [build/python.json ...]
+    python compare_baseline.py baseline.json build/native.json --update
+
+Cases are matched on (name, size, symbols). A case is flagged as a regression
+when its median time exceeds the baseline median by more than --threshold.
+Exits with status 1 if any regression is found.
+"""
+import argparse
+import json
+import sys
+
+
+def load_results(path):
+    with open(path) as f:
+        doc = json.load(f)
+    return {(r["name"], r["size"], r["symbols"]): r for r in doc.get("results", [])}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flag benchmark slowdowns against a baseline")
+    parser.add_argument("baseline")
+    parser.add_argument("current", nargs="+")
+    parser.add_argument("--threshold", type=float, default=0.15,
+                        help="allowed relative slowdown before flagging (default 0.15 = 15%%)")
+    parser.add_argument("--update", action="store_true",
+                        help="overwrite the baseline with the current results instead of comparing")
+    args = parser.parse_args()
+
+    current = {}
+    for path in args.current:
+        current.update(load_results(path))
+
+    if args.update:
+        results = [current[k] for k in sorted(current)]
+        with open(args.baseline, "w") as f:
+            json.dump({"suite": "baseline", "results": results}, f, indent=2)
+            f.write("\n")
+        print(f"Wrote {len(results)} cases to {args.baseline}")
+        return 0
+
+    try:
+        baseline = load_results(args.baseline)
+    except FileNotFoundError:
+        print(f"No baseline at {args.baseline}; run with --update to create one")
+        return 1
+
+    regressions = []
+    print(f"{'case':<58} {'baseline':>12} {'current':>12} {'change':>8}")
+    for key in sorted(current):
+        name, size, symbols = key
+        label = f"{name} size={size} symbols={symbols}"
+        cur = current[key]["median_ns"]
+        if key not in baseline:
+            print(f"{label:<58} {'-':>12} {cur:>12.0f} {'new':>8}")
+            continue
+        base = baseline[key]["median_ns"]
+        change = (cur - base) / base if base > 0 else 0.0
+        marker = ""
+        if change > args.threshold:
+            regressions.append(label)
+            marker = "  <-- SLOWER"
+        print(f"{label:<58} {base:>12.0f} {cur:>12.0f} {change:>+7.1%}{marker}")
+
+    missing = sorted(set(baseline) - set(current))
+    if missing:
+        print(f"\n{len(missing)} baseline cases were not run (filtered or smaller profile)")
+
+    if regressions:
+        print(f"\n{len(regressions)} regression(s) above {args.threshold:.0%}:")
+        for label in regressions:
+            print(f"  {label}")
+        return 1
+
+    print("\nNo regressions")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
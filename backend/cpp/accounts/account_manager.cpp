@@ -0,0 +1,246 @@
+#include "account_manager.h"
+#include "../utils/parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace traider {
+namespace accounts {
+
+    AccountManager::AccountManager(size_t num_shards, RankMetric metric, size_t queue_capacity)
+        : metric_(metric),
+          queue_capacity_(queue_capacity),
+          shards_(num_shards == 0 ? utils::default_thread_count() : num_shards),
+          workers_(std::min(shards_.size(), utils::default_thread_count())) {}
+
+    bool AccountManager::open_account(const std::string& user_id, double initial_capital) {
+        std::lock_guard<std::mutex> process_lock(process_mutex_);
+        std::unique_lock<std::shared_mutex> lock(directory_mutex_);
+        if (directory_.count(user_id)) return false;
+
+        uint32_t id = static_cast<uint32_t>(accounts_.size());
+        accounts_.push_back(std::make_unique<Account>(id, user_id, initial_capital, queue_capacity_));
+        directory_.emplace(user_id, id);
+
+        Account& account = *accounts_.back();
+        shards_[id % shards_.size()].accounts.push_back(&account);
+        leaderboard_.upsert(id, account.score);
+        return true;
+    }
+
+    bool AccountManager::has_account(const std::string& user_id) const {
+        std::shared_lock<std::shared_mutex> lock(directory_mutex_);
+        return directory_.count(user_id) > 0;
+    }
+
+    uint64_t AccountManager::submit_order(const std::string& user_id, const std::string& ticker,
+                                          double quantity, core::OrderSide side) {
+        if (quantity <= 0) return 0;
+
+        Account* account;
+        {
+            std::shared_lock<std::shared_mutex> lock(directory_mutex_);
+            auto it = directory_.find(user_id);
+            if (it == directory_.end()) return 0;
+            account = accounts_[it->second].get();
+        }
+        uint64_t order_id = next_order_id_.fetch_add(1, std::memory_order_relaxed);
+        if (!account->orders.try_push(OrderRequest{order_id, ticker, quantity, side})) return 0;
+        return order_id;
+    }
+
+    void AccountManager::update_price(const std::string& ticker, double price) {
+        if (price <= 0) return;
+        std::lock_guard<std::mutex> lock(prices_mutex_);
+        pending_prices_.emplace_back(ticker, price);
+    }
+
+    size_t AccountManager::process() {
+        std::lock_guard<std::mutex> process_lock(process_mutex_);
+
+        std::vector<std::pair<std::string, double>> raw;
+        {
+            std::lock_guard<std::mutex> lock(prices_mutex_);
+            raw.swap(pending_prices_);
+        }
+
+        // Coalesce repeated ticks per symbol: only the latest price matters for valuation
+        std::vector<std::pair<std::string, double>> ticks;
+        std::unordered_map<std::string, size_t> tick_index;
+        for (auto& tick : raw) {
+            auto it = tick_index.find(tick.first);
+            if (it == tick_index.end()) {
+                tick_index.emplace(tick.first, ticks.size());
+                ticks.push_back(std::move(tick));
+            } else {
+                ticks[it->second].second = tick.second;
+            }
+        }
+        for (const auto& tick : ticks) last_prices_[tick.first] = tick.second;
+
+        std::vector<size_t> executed(shards_.size(), 0);
+        workers_.run(shards_.size(), [&](size_t s) { process_shard(shards_[s], ticks, executed[s]); });
+
+        size_t total = 0;
+        for (size_t s = 0; s < shards_.size(); ++s) {
+            total += executed[s];
+            for (Account* account : shards_[s].dirty) {
+                leaderboard_.upsert(account->id, account->score);
+                account->dirty = false;
+            }
+            shards_[s].dirty.clear();
+        }
+        return total;
+    }
+
+    void AccountManager::process_shard(Shard& shard, const std::vector<std::pair<std::string, double>>& ticks,
+                                       size_t& executed) {
+        auto mark_dirty = [&shard](Account* account) {
+            if (!account->dirty) {
+                account->dirty = true;
+                shard.dirty.push_back(account);
+            }
+        };
+
+        // Fan out prices to holders only
+        for (const auto& tick : ticks) {
+            auto it = shard.holders.find(tick.first);
+            if (it == shard.holders.end()) continue;
+            for (Account* account : it->second) {
+                account->engine.update_price(tick.first, tick.second);
+                mark_dirty(account);
+            }
+        }
+
+        OrderRequest order;
+        for (Account* account : shard.accounts) {
+            auto report = [account](const OrderRequest& o, OrderStatus status, double price) {
+                auto& results = account->results;
+                if (results.size() >= kMaxOrderResults) {
+                    results.erase(results.begin(), results.begin() + kMaxOrderResults / 2);
+                }
+                results.push_back(OrderResult{o.order_id, o.ticker, status, o.quantity, price});
+            };
+
+            while (account->orders.try_pop(order)) {
+                // last_prices_ is only written under process_mutex_ before shards run
+                auto last = last_prices_.find(order.ticker);
+                if (last == last_prices_.end()) {
+                    report(order, OrderStatus::NO_PRICE, 0.0);
+                    continue;
+                }
+                double fill = last->second;
+
+                const auto& positions = account->engine.get_positions();
+                bool held_before = positions.count(order.ticker) > 0;
+                size_t trades_before = account->engine.get_trade_history().size();
+
+                account->engine.execute_trade(order.ticker, order.quantity, fill, order.side);
+                if (account->engine.get_trade_history().size() == trades_before) {
+                    report(order, OrderStatus::REJECTED, 0.0);
+                    continue;
+                }
+
+                ++executed;
+                report(order, OrderStatus::FILLED, fill);
+                account->engine.update_price(order.ticker, fill);
+                refresh_holdings(shard, *account, order.ticker, held_before);
+                mark_dirty(account);
+            }
+        }
+
+        for (Account* account : shard.dirty) rescore(*account);
+    }
+
+    void AccountManager::refresh_holdings(Shard& shard, Account& account, const std::string& ticker, bool held_before) {
+        bool held_after = account.engine.get_positions().count(ticker) > 0;
+        if (held_after == held_before) return;
+
+        auto& holders = shard.holders[ticker];
+        if (held_after) {
+            holders.push_back(&account);
+        } else {
+            holders.erase(std::remove(holders.begin(), holders.end(), &account), holders.end());
+            if (holders.empty()) shard.holders.erase(ticker);
+        }
+    }
+
+    void AccountManager::rescore(Account& account) {
+        double value = account.engine.get_portfolio_value();
+        if (account.last_value > 0) {
+            double r = value / account.last_value - 1.0;
+            account.n_returns += 1;
+            double delta = r - account.mean_return;
+            account.mean_return += delta / account.n_returns;
+            account.m2_return += delta * (r - account.mean_return);
+        }
+        account.last_value = value;
+
+        if (metric_ == RankMetric::SHARPE) {
+            double sd = account.n_returns > 1 ? std::sqrt(account.m2_return / (account.n_returns - 1)) : 0.0;
+            account.score = sd > 1e-12 ? account.mean_return / sd : 0.0;
+        } else {
+            account.score = account.initial_capital > 0 ? (value / account.initial_capital - 1.0) * 100.0 : 0.0;
+        }
+    }
+
+    LeaderboardEntry AccountManager::make_entry(const Account& account, size_t rank) const {
+        LeaderboardEntry entry;
+        entry.user_id = account.user_id;
+        entry.rank = rank;
+        entry.score = account.score;
+        entry.portfolio_value = account.last_value;
+        entry.total_return = account.initial_capital > 0
+            ? (account.last_value / account.initial_capital - 1.0) * 100.0 : 0.0;
+        double sd = account.n_returns > 1 ? std::sqrt(account.m2_return / (account.n_returns - 1)) : 0.0;
+        entry.sharpe_ratio = sd > 1e-12 ? account.mean_return / sd : 0.0;
+        return entry;
+    }
+
+    std::vector<OrderResult> AccountManager::take_order_results(const std::string& user_id) {
+        std::lock_guard<std::mutex> process_lock(process_mutex_);
+        std::shared_lock<std::shared_mutex> lock(directory_mutex_);
+        auto it = directory_.find(user_id);
+        if (it == directory_.end()) return {};
+        std::vector<OrderResult> results;
+        results.swap(accounts_[it->second]->results);
+        return results;
+    }
+
+    std::vector<LeaderboardEntry> AccountManager::leaderboard(size_t n) const {
+        std::lock_guard<std::mutex> lock(process_mutex_);
+        std::vector<LeaderboardEntry> result;
+        auto top = leaderboard_.top(n);
+        result.reserve(top.size());
+        for (size_t i = 0; i < top.size(); ++i) {
+            result.push_back(make_entry(*accounts_[top[i].first], i + 1));
+        }
+        return result;
+    }
+
+    size_t AccountManager::rank_of(const std::string& user_id) const {
+        std::lock_guard<std::mutex> lock(process_mutex_);
+        auto it = directory_.find(user_id);
+        if (it == directory_.end()) return 0;
+        return leaderboard_.rank(it->second);
+    }
+
+    const core::TradingEngine& AccountManager::get_engine(const std::string& user_id) const {
+        std::shared_lock<std::shared_mutex> lock(directory_mutex_);
+        auto it = directory_.find(user_id);
+        if (it == directory_.end()) throw std::invalid_argument("Unknown account: " + user_id);
+        return accounts_[it->second]->engine;
+    }
+
+    core::TradingEngine AccountManager::engine_snapshot(const std::string& user_id) const {
+        std::lock_guard<std::mutex> process_lock(process_mutex_);
+        return get_engine(user_id);
+    }
+
+    size_t AccountManager::size() const {
+        std::shared_lock<std::shared_mutex> lock(directory_mutex_);
+        return accounts_.size();
+    }
+
+} // namespace accounts
+} // namespace traider
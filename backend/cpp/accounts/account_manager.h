@@ -0,0 +1,166 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../core/trading_engine.h"
+#include "../utils/lockfree_queue.h"
+#include "../utils/worker_pool.h"
+#include "leaderboard.h"
+
+namespace traider {
+namespace accounts {
+
+    enum class RankMetric {
+        TOTAL_RETURN,
+        SHARPE
+    };
+
+    enum class OrderStatus {
+        FILLED,
+        NO_PRICE, // No shared price for the ticker yet
+        REJECTED  // Insufficient cash or shares
+    };
+
+    struct OrderRequest {
+        uint64_t order_id;
+        std::string ticker;
+        double quantity;
+        core::OrderSide side;
+    };
+
+    struct OrderResult {
+        uint64_t order_id;
+        std::string ticker;
+        OrderStatus status;
+        double quantity;
+        double price; // Fill price, 0 unless FILLED
+    };
+
+    struct LeaderboardEntry {
+        std::string user_id;
+        size_t rank;
+        double score;
+        double total_return; // Percent
+        double sharpe_ratio; // Per revaluation step, not annualized
+        double portfolio_value;
+    };
+
+    /**
+     * @brief Hosts many simulator accounts, each backed by its own TradingEngine.
+     *
+     * Accounts are spread round-robin over shards that are processed in parallel
+     * on worker threads owned by the manager.
+     * submit_order() only touches the account's lock-free queue and may be
+     * called from any thread; orders take effect on the next process().
+     * Price updates are buffered and, on process(), fanned out only to the
+     * accounts holding the symbol. Only accounts that traded or were repriced
+     * are rescored, and the leaderboard is updated in O(log n) per account.
+     */
+    class AccountManager {
+    public:
+        /**
+         * @param num_shards Shards to spread accounts over (0 = hardware concurrency)
+         * @param metric Leaderboard ordering
+         * @param queue_capacity Pending orders per account before submit_order rejects
+         */
+        AccountManager(size_t num_shards = 0, RankMetric metric = RankMetric::TOTAL_RETURN,
+                       size_t queue_capacity = 256);
+
+        // Returns false if the user already has an account
+        bool open_account(const std::string& user_id, double initial_capital);
+        bool has_account(const std::string& user_id) const;
+
+        // Lock-free enqueue of a market order; it fills at the last shared price for the
+        // ticker. Returns the order id, or 0 for unknown users or a full queue.
+        uint64_t submit_order(const std::string& user_id, const std::string& ticker,
+                              double quantity, core::OrderSide side);
+
+        // Buffer a shared price tick; applied to holders on the next process()
+        void update_price(const std::string& ticker, double price);
+
+        /**
+         * @brief Apply buffered prices, drain every order queue and refresh rankings.
+         * @return Number of orders executed
+         */
+        size_t process();
+
+        /**
+         * @brief Drain the outcomes of the user's orders handled by process() so far.
+         * Every accepted order yields exactly one result; only the most recent
+         * kMaxOrderResults are kept per account.
+         */
+        std::vector<OrderResult> take_order_results(const std::string& user_id);
+
+        static constexpr size_t kMaxOrderResults = 1024;
+
+        std::vector<LeaderboardEntry> leaderboard(size_t n) const;
+        size_t rank_of(const std::string& user_id) const;
+
+        // Not synchronized with process(); read while no processing is in flight
+        const core::TradingEngine& get_engine(const std::string& user_id) const;
+
+        // Copy of the account's engine taken under the processing lock; safe while
+        // process() runs on other threads (e.g. a replay driving the accounts)
+        core::TradingEngine engine_snapshot(const std::string& user_id) const;
+
+        size_t size() const;
+        size_t num_shards() const { return shards_.size(); }
+
+    private:
+        struct Account {
+            Account(uint32_t id_, const std::string& user, double capital, size_t queue_capacity)
+                : id(id_), user_id(user), engine(capital), orders(queue_capacity),
+                  initial_capital(capital), last_value(capital) {}
+
+            uint32_t id;
+            std::string user_id;
+            core::TradingEngine engine;
+            utils::BoundedMpscQueue<OrderRequest> orders;
+            std::vector<OrderResult> results; // Written by process(), drained by take_order_results()
+            double initial_capital;
+            double last_value;
+            // Welford stats over per-revaluation returns, for the Sharpe metric
+            size_t n_returns = 0;
+            double mean_return = 0.0;
+            double m2_return = 0.0;
+            double score = 0.0;
+            bool dirty = false;
+        };
+
+        struct Shard {
+            std::vector<Account*> accounts;
+            std::unordered_map<std::string, std::vector<Account*>> holders;
+            std::vector<Account*> dirty;
+        };
+
+        void process_shard(Shard& shard, const std::vector<std::pair<std::string, double>>& ticks,
+                           size_t& executed);
+        void refresh_holdings(Shard& shard, Account& account, const std::string& ticker, bool held_before);
+        void rescore(Account& account);
+        LeaderboardEntry make_entry(const Account& account, size_t rank) const;
+
+        RankMetric metric_;
+        size_t queue_capacity_;
+        std::atomic<uint64_t> next_order_id_{1};
+        std::vector<Shard> shards_;
+        std::vector<std::unique_ptr<Account>> accounts_;
+
+        mutable std::shared_mutex directory_mutex_;
+        std::unordered_map<std::string, uint32_t> directory_;
+
+        std::mutex prices_mutex_;
+        std::vector<std::pair<std::string, double>> pending_prices_;
+        std::unordered_map<std::string, double> last_prices_;
+
+        mutable std::mutex process_mutex_;
+        Leaderboard leaderboard_;
+        utils::WorkerPool workers_; // Kept across process() calls (one per order, one per replay tick)
+    };
+
+} // namespace accounts
+} // namespace traider
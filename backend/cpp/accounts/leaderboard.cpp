@@ -0,0 +1,140 @@
+#include "leaderboard.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace traider {
+namespace accounts {
+
+    namespace {
+        // NaN scores (e.g. Sharpe before any returns) sort last
+        inline double sanitize(double score) {
+            return std::isnan(score) ? -std::numeric_limits<double>::infinity() : score;
+        }
+    }
+
+    bool Leaderboard::ahead(double score, uint32_t id, int n) const {
+        const Node& node = nodes_[n];
+        if (score != node.score) return score > node.score;
+        return id < static_cast<uint32_t>(n);
+    }
+
+    void Leaderboard::pull(int n) {
+        nodes_[n].size = 1 + size_of(nodes_[n].left) + size_of(nodes_[n].right);
+    }
+
+    // left: nodes ranked ahead of (score, id); right: the rest
+    void Leaderboard::split(int t, double score, uint32_t id, int& left, int& right) {
+        if (t < 0) {
+            left = right = -1;
+            return;
+        }
+        if (ahead(score, id, t)) {
+            split(nodes_[t].left, score, id, left, nodes_[t].left);
+            right = t;
+        } else {
+            split(nodes_[t].right, score, id, nodes_[t].right, right);
+            left = t;
+        }
+        pull(t);
+    }
+
+    int Leaderboard::merge(int a, int b) {
+        if (a < 0) return b;
+        if (b < 0) return a;
+        if (nodes_[a].priority > nodes_[b].priority) {
+            nodes_[a].right = merge(nodes_[a].right, b);
+            pull(a);
+            return a;
+        }
+        nodes_[b].left = merge(a, nodes_[b].left);
+        pull(b);
+        return b;
+    }
+
+    int Leaderboard::erase_rec(int t, double score, uint32_t id) {
+        if (t < 0) return -1;
+        if (static_cast<uint32_t>(t) == id) {
+            return merge(nodes_[t].left, nodes_[t].right);
+        }
+        if (ahead(score, id, t)) {
+            nodes_[t].left = erase_rec(nodes_[t].left, score, id);
+        } else {
+            nodes_[t].right = erase_rec(nodes_[t].right, score, id);
+        }
+        pull(t);
+        return t;
+    }
+
+    void Leaderboard::upsert(uint32_t id, double score) {
+        score = sanitize(score);
+        if (id >= nodes_.size()) nodes_.resize(id + 1);
+
+        Node& node = nodes_[id];
+        if (node.present) {
+            if (node.score == score) return;
+            erase(id);
+        }
+
+        // xorshift32 priorities keep the treap balanced in expectation
+        rng_state_ ^= rng_state_ << 13;
+        rng_state_ ^= rng_state_ >> 17;
+        rng_state_ ^= rng_state_ << 5;
+
+        node.score = score;
+        node.priority = rng_state_;
+        node.size = 1;
+        node.left = node.right = -1;
+        node.present = true;
+
+        int left, right;
+        split(root_, score, id, left, right);
+        root_ = merge(merge(left, static_cast<int>(id)), right);
+    }
+
+    void Leaderboard::erase(uint32_t id) {
+        if (id >= nodes_.size() || !nodes_[id].present) return;
+        root_ = erase_rec(root_, nodes_[id].score, id);
+        nodes_[id].present = false;
+    }
+
+    size_t Leaderboard::rank(uint32_t id) const {
+        if (id >= nodes_.size() || !nodes_[id].present) return 0;
+        double score = nodes_[id].score;
+
+        size_t before = 0;
+        int t = root_;
+        while (t >= 0) {
+            if (static_cast<uint32_t>(t) == id) return before + size_of(nodes_[t].left) + 1;
+            if (ahead(score, id, t)) {
+                t = nodes_[t].left;
+            } else {
+                before += size_of(nodes_[t].left) + 1;
+                t = nodes_[t].right;
+            }
+        }
+        return 0;
+    }
+
+    std::vector<std::pair<uint32_t, double>> Leaderboard::top(size_t n) const {
+        std::vector<std::pair<uint32_t, double>> result;
+        result.reserve(std::min(n, size()));
+
+        // Iterative in-order walk, stopping after n nodes
+        std::vector<int> stack;
+        int t = root_;
+        while ((t >= 0 || !stack.empty()) && result.size() < n) {
+            while (t >= 0) {
+                stack.push_back(t);
+                t = nodes_[t].left;
+            }
+            t = stack.back();
+            stack.pop_back();
+            result.emplace_back(static_cast<uint32_t>(t), nodes_[t].score);
+            t = nodes_[t].right;
+        }
+        return result;
+    }
+
+} // namespace accounts
+} // namespace traider
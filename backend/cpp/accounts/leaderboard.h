@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace traider {
+namespace accounts {
+
+    /**
+     * @brief Order-statistic ranking of account scores (highest first).
+     *
+     * Implicit treap keyed on (score desc, id asc) with subtree sizes, so
+     * upsert/erase/rank are O(log n) and top(k) is O(log n + k). Ids are dense
+     * account indices; one node per id is kept in a flat array.
+     */
+    class Leaderboard {
+    public:
+        void upsert(uint32_t id, double score);
+        void erase(uint32_t id);
+
+        // 1-based rank, or 0 if the id is not ranked
+        size_t rank(uint32_t id) const;
+
+        // Best `n` entries as {id, score}
+        std::vector<std::pair<uint32_t, double>> top(size_t n) const;
+
+        size_t size() const { return root_ < 0 ? 0 : nodes_[root_].size; }
+
+    private:
+        struct Node {
+            double score = 0.0;
+            uint32_t priority = 0;
+            uint32_t size = 1;
+            int left = -1;
+            int right = -1;
+            bool present = false;
+        };
+
+        // True if key (score, id) ranks ahead of node `n`
+        bool ahead(double score, uint32_t id, int n) const;
+        uint32_t size_of(int n) const { return n < 0 ? 0 : nodes_[n].size; }
+        void pull(int n);
+        void split(int t, double score, uint32_t id, int& left, int& right);
+        int merge(int a, int b);
+        int erase_rec(int t, double score, uint32_t id);
+
+        std::vector<Node> nodes_;
+        int root_ = -1;
+        uint32_t rng_state_ = 2463534242u;
+    };
+
+} // namespace accounts
+} // namespace traider
@@ -1,56 +1,222 @@
 #include "backtest_engine.h"
+#include "../metrics/instrumentation.h"
+#include <algorithm>
+#include <mutex>
 
 namespace traider {
 namespace backtesting {
 
     BacktestEngine::BacktestEngine(double initial_capital) 
-        : engine_(initial_capital) {}
+        : initial_capital_(initial_capital), engine_(initial_capital) {}
 
     BacktestResult BacktestEngine::run_simple(
         const std::string& ticker,
         const std::vector<double>& prices,
         const std::vector<int>& signals
+    ) {
+        static const int loop_probe = metrics::register_probe("backtesting.run_simple.loop");
+        static const int metrics_probe = metrics::register_probe("backtesting.run_simple.metrics");
+
+        BacktestResult result;
+        if (prices.size() != signals.size()) return result;
+
+        result.equity_curve.reserve(prices.size());
+
+        {
+            metrics::ScopedTimer loop_timer(loop_probe, prices.size() * (sizeof(double) + sizeof(int)));
+            for (size_t i = 0; i < prices.size(); ++i) {
+                // Update Price
+                engine_.update_price(ticker, prices[i]);
+
+                // Execute Signal
+                // Simple logic: Buy all capital, Sell all position
+                // In real engine, signals should be more complex orders
+                int signal = signals[i];
+            
+                if (signal == 1) { // BUY
+                    double capital = engine_.get_capital();
+                    if (capital > 0) {
+                        double qty = capital / prices[i];
+                        // Apply slight slippage/fee model? For now, raw.
+                        engine_.execute_trade(ticker, qty, prices[i], core::OrderSide::BUY);
+                    }
+                } else if (signal == -1) { // SELL
+                    const auto& positions = engine_.get_positions();
+                    auto it = positions.find(ticker);
+                    if (it != positions.end() && it->second.quantity > 0) {
+                        engine_.execute_trade(ticker, it->second.quantity, prices[i], core::OrderSide::SELL);
+                    }
+                }
+
+                // Record Equity
+                result.equity_curve.push_back(engine_.get_portfolio_value());
+            }
+        }
+
+        // Calculate Metrics
+        {
+            metrics::ScopedTimer timer(metrics_probe, result.equity_curve.size() * sizeof(double));
+            result.metrics = portfolio::PortfolioAnalytics::calculate_metrics(result.equity_curve);
+        }
+        result.trades = engine_.get_trade_history();
+
+        return result;
+    }
+
+    BacktestResult BacktestEngine::run_simple_fixed(
+        const std::string& ticker,
+        const std::vector<double>& prices,
+        const std::vector<int>& signals,
+        const core::FixedPointConfig& config
     ) {
         BacktestResult result;
         if (prices.size() != signals.size()) return result;
 
+        core::FixedTradingEngine engine(config.cash_to_units(initial_capital_), config);
+        int64_t lot = config.lot_size > 0 ? config.lot_size : 1;
         result.equity_curve.reserve(prices.size());
 
         for (size_t i = 0; i < prices.size(); ++i) {
-            // Update Price
-            engine_.update_price(ticker, prices[i]);
+            int64_t price = config.price_to_ticks(prices[i]);
+            engine.update_price(ticker, price);
 
-            // Execute Signal
-            // Simple logic: Buy all capital, Sell all position
-            // In real engine, signals should be more complex orders
             int signal = signals[i];
-            
-            if (signal == 1) { // BUY
-                double capital = engine_.get_capital();
-                if (capital > 0) {
-                    double qty = capital / prices[i];
-                    // Apply slight slippage/fee model? For now, raw.
-                    engine_.execute_trade(ticker, qty, prices[i], core::OrderSide::BUY);
+            if (signal == 1 && price > 0) { // BUY as many whole lots as cash allows
+                int64_t lot_value;
+                int64_t qty = core::checked_mul(price, lot, lot_value) ? (engine.get_cash() / lot_value) * lot : 0;
+                if (qty > 0) {
+                    engine.execute_trade(ticker, qty, price, core::OrderSide::BUY);
                 }
             } else if (signal == -1) { // SELL
-                const auto& positions = engine_.get_positions();
+                const auto& positions = engine.get_positions();
                 auto it = positions.find(ticker);
-                if (it != positions.end() && it->second.quantity > 0) {
-                    engine_.execute_trade(ticker, it->second.quantity, prices[i], core::OrderSide::SELL);
+                if (it != positions.end()) {
+                    engine.execute_trade(ticker, it->second.quantity, price, core::OrderSide::SELL);
                 }
             }
 
-            // Record Equity
-            result.equity_curve.push_back(engine_.get_portfolio_value());
+            result.equity_curve.push_back(config.units_to_cash(engine.get_portfolio_value()));
         }
 
-        // Calculate Metrics
         result.metrics = portfolio::PortfolioAnalytics::calculate_metrics(result.equity_curve);
-        result.trades = engine_.get_trade_history();
+
+        const auto& history = engine.get_trade_history();
+        result.trades.reserve(history.size());
+        for (const auto& fixed : history) {
+            core::Order order;
+            order.id = fixed.id;
+            order.ticker = fixed.ticker;
+            order.type = fixed.type;
+            order.side = fixed.side;
+            order.quantity = config.units_to_quantity(fixed.quantity);
+            order.price = config.ticks_to_price(fixed.price);
+            order.timestamp = static_cast<double>(fixed.timestamp);
+            result.trades.push_back(order);
+        }
 
         return result;
     }
 
+    bool BacktestEngine::run_simple_into(
+        const std::vector<double>& prices,
+        const std::vector<int>& signals,
+        BacktestWorkspace& workspace
+    ) const {
+        workspace.reset();
+        if (prices.size() != signals.size()) return false;
+        workspace.reserve(prices.size(), 0);
+
+        // Flat single-asset book mirroring TradingEngine's accounting step for step,
+        // so results match run_simple on a fresh engine without map nodes or strings.
+        double capital = initial_capital_;
+        double quantity = 0.0;
+        double average_price = 0.0;
+        double current_price = 0.0;
+
+        auto record = [&workspace](size_t bar, core::OrderSide side, double qty, double price) {
+            auto& trades = workspace.trades_;
+            if (trades.size() == trades.capacity()) ++workspace.growth_count_;
+            trades.push_back(TradeRecord{static_cast<uint32_t>(bar), side, qty, price});
+        };
+
+        for (size_t i = 0; i < prices.size(); ++i) {
+            double price = prices[i];
+            if (quantity > 0) current_price = price;
+
+            int signal = signals[i];
+            if (signal == 1 && capital > 0 && price > 0) { // BUY
+                double qty = capital / price;
+                double trade_value = qty * price;
+                if (qty > 0 && capital >= trade_value) {
+                    capital -= trade_value;
+                    if (quantity == 0) {
+                        average_price = price;
+                        quantity = qty;
+                        current_price = 0.0; // TradingEngine leaves a new position unmarked until the next bar
+                    } else {
+                        double total_cost = (quantity * average_price) + trade_value;
+                        quantity += qty;
+                        average_price = total_cost / quantity;
+                    }
+                    record(i, core::OrderSide::BUY, qty, price);
+                }
+            } else if (signal == -1 && quantity > 0 && price > 0) { // SELL
+                capital += quantity * price;
+                record(i, core::OrderSide::SELL, quantity, price);
+                quantity = 0.0;
+            }
+
+            workspace.equity_curve_.push_back(capital + quantity * current_price);
+        }
+
+        workspace.metrics_ = portfolio::PortfolioAnalytics::calculate_metrics(workspace.equity_curve_);
+        return true;
+    }
+
+    std::vector<portfolio::PortfolioMetrics> BacktestEngine::run_simple_sweep(
+        const std::vector<double>& prices,
+        const std::vector<std::vector<int>>& signal_sets,
+        std::vector<BacktestWorkspace>& workspaces,
+        utils::WorkerPool& workers,
+        size_t num_threads
+    ) const {
+        size_t n = signal_sets.size();
+        std::vector<portfolio::PortfolioMetrics> results(n, {0.0, 0.0, 0.0, 0.0, 0.0});
+        if (n == 0) return results;
+
+        if (num_threads == 0 || num_threads > workers.size()) num_threads = workers.size();
+        size_t chunks = std::min(num_threads, n);
+        if (workspaces.size() < chunks) workspaces.resize(chunks);
+        size_t step = (n + chunks - 1) / chunks;
+
+        // Each chunk index is handed out once, so chunk c owns workspaces[c] exclusively
+        workers.run(chunks, [&](size_t c) {
+            BacktestWorkspace& workspace = workspaces[c];
+            for (size_t i = c * step; i < std::min(n, (c + 1) * step); ++i) {
+                if (run_simple_into(prices, signal_sets[i], workspace)) {
+                    results[i] = workspace.metrics();
+                }
+            }
+        });
+        return results;
+    }
+
+    std::vector<portfolio::PortfolioMetrics> BacktestEngine::run_simple_sweep(
+        const std::vector<double>& prices,
+        const std::vector<std::vector<int>>& signal_sets,
+        size_t num_threads
+    ) const {
+        static std::mutex shared_mutex;
+        static utils::WorkerPool shared_workers;
+        static std::vector<BacktestWorkspace> shared_workspaces;
+
+        std::unique_lock<std::mutex> lock(shared_mutex, std::try_to_lock);
+        if (lock.owns_lock()) return run_simple_sweep(prices, signal_sets, shared_workspaces, shared_workers, num_threads);
+
+        utils::WorkerPool call_workers(num_threads);
+        std::vector<BacktestWorkspace> call_workspaces;
+        return run_simple_sweep(prices, signal_sets, call_workspaces, call_workers, num_threads);
+    }
+
 } // namespace backtesting
 } // namespace traider
-
@@ -3,8 +3,11 @@
 #include <vector>
 #include <string>
 #include "../core/trading_engine.h"
+#include "../core/fixed_trading_engine.h"
 #include "../data/data_processor.h"
 #include "../portfolio/portfolio_analytics.h"
+#include "../utils/worker_pool.h"
+#include "backtest_workspace.h"
 
 namespace traider {
 namespace backtesting {
@@ -30,7 +33,59 @@ namespace backtesting {
             const std::vector<int>& signals
         );
 
+        /**
+         * @brief Same strategy as run_simple on a fresh FixedTradingEngine: prices are
+         * rounded to ticks and buys take whole lots, so P&L is exactly reproducible.
+         * Equity and trades are converted back to doubles at the end.
+         */
+        BacktestResult run_simple_fixed(
+            const std::string& ticker,
+            const std::vector<double>& prices,
+            const std::vector<int>& signals,
+            const core::FixedPointConfig& config = core::FixedPointConfig()
+        );
+
+        /**
+         * @brief Allocation-free run_simple: same strategy and arithmetic, starting from
+         * the initial capital on a flat single-asset book and writing into `workspace`
+         * (which is reset first). Does not touch the engine's persistent account.
+         * @return false if prices and signals differ in length
+         */
+        bool run_simple_into(
+            const std::vector<double>& prices,
+            const std::vector<int>& signals,
+            BacktestWorkspace& workspace
+        ) const;
+
+        /**
+         * @brief Parameter sweep: one run_simple_into per signal set, spread over `workers`.
+         * The signal sets are split into contiguous chunks, one per thread taking part,
+         * and chunk c runs in workspaces[c] (grown to the chunk count if smaller).
+         * A caller that keeps both the workspaces and the pool across sweeps starts
+         * no threads and only allocates the returned metrics once warmed up.
+         * @param num_threads Chunks to split into, capped at workers.size() (0 = workers.size())
+         */
+        std::vector<portfolio::PortfolioMetrics> run_simple_sweep(
+            const std::vector<double>& prices,
+            const std::vector<std::vector<int>>& signal_sets,
+            std::vector<BacktestWorkspace>& workspaces,
+            utils::WorkerPool& workers,
+            size_t num_threads = 0
+        ) const;
+
+        /**
+         * @brief Sweep on process-wide workers and workspaces. A sweep that finds them
+         * in use by another thread starts its own for that call.
+         * @param num_threads Worker threads (0 = hardware concurrency)
+         */
+        std::vector<portfolio::PortfolioMetrics> run_simple_sweep(
+            const std::vector<double>& prices,
+            const std::vector<std::vector<int>>& signal_sets,
+            size_t num_threads = 0
+        ) const;
+
     private:
+        double initial_capital_;
         core::TradingEngine engine_;
     };
 
@@ -0,0 +1,28 @@
+#include "backtest_workspace.h"
+
+namespace traider {
+namespace backtesting {
+
+    BacktestWorkspace::BacktestWorkspace(size_t expected_bars, size_t expected_trades) {
+        reserve(expected_bars, expected_trades);
+    }
+
+    void BacktestWorkspace::reset() {
+        equity_curve_.clear();
+        trades_.clear();
+        metrics_ = {0.0, 0.0, 0.0, 0.0, 0.0};
+    }
+
+    void BacktestWorkspace::reserve(size_t bars, size_t trades) {
+        if (bars > equity_curve_.capacity()) {
+            equity_curve_.reserve(bars);
+            ++growth_count_;
+        }
+        if (trades > trades_.capacity()) {
+            trades_.reserve(trades);
+            ++growth_count_;
+        }
+    }
+
+} // namespace backtesting
+} // namespace traider
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../core/trading_engine.h"
+#include "../portfolio/portfolio_analytics.h"
+
+namespace traider {
+namespace backtesting {
+
+    // Compact trade record: bar index instead of a ticker string copy.
+    struct TradeRecord {
+        uint32_t bar;
+        core::OrderSide side;
+        double quantity;
+        double price;
+    };
+
+    /**
+     * @brief Reusable output buffers for BacktestEngine::run_simple_into.
+     *
+     * reset() only rewinds sizes (the element types are trivially destructible),
+     * so buffers keep their capacity and repeated runs of similar length do no
+     * heap allocation once warmed up. Parameter sweeps give each chunk its own
+     * workspace from a pool kept alongside the sweep's workers (see run_simple_sweep).
+     */
+    class BacktestWorkspace {
+    public:
+        BacktestWorkspace() = default;
+        BacktestWorkspace(size_t expected_bars, size_t expected_trades);
+
+        void reset();
+        void reserve(size_t bars, size_t trades);
+
+        const std::vector<double>& equity_curve() const { return equity_curve_; }
+        const std::vector<TradeRecord>& trades() const { return trades_; }
+        const portfolio::PortfolioMetrics& metrics() const { return metrics_; }
+
+        // Number of times a buffer had to grow; stays flat in steady state
+        size_t growth_count() const { return growth_count_; }
+
+    private:
+        friend class BacktestEngine;
+
+        std::vector<double> equity_curve_;
+        std::vector<TradeRecord> trades_;
+        portfolio::PortfolioMetrics metrics_{0.0, 0.0, 0.0, 0.0, 0.0};
+        size_t growth_count_ = 0;
+    };
+
+} // namespace backtesting
+} // namespace traider
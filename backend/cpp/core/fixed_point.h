@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace traider {
+namespace core {
+
+    /**
+     * @brief Scales for the fixed-point trading mode.
+     *
+     * Prices are int64 ticks of 1/price_scale, quantities are int64 units of
+     * 1/quantity_scale shares, and cash is kept in price_ticks * quantity_units,
+     * so every fill is an exact integer product with no rounding.
+     * The *_to_ticks/units conversions throw std::invalid_argument for NaN or
+     * infinite input and std::out_of_range when the scaled value does not fit
+     * in int64, rather than letting llround wrap.
+     */
+    struct FixedPointConfig {
+        int64_t price_scale = 10000; // 1 tick = 0.0001
+        int64_t quantity_scale = 1;  // whole shares
+        int64_t lot_size = 1;        // orders must be a multiple of this many units
+
+        FixedPointConfig() = default;
+        FixedPointConfig(int64_t price_scale_, int64_t quantity_scale_, int64_t lot_size_ = 1)
+            : price_scale(price_scale_), quantity_scale(quantity_scale_), lot_size(lot_size_) {
+            validate();
+        }
+
+        // Throws std::invalid_argument unless every scale and the lot size are > 0
+        void validate() const {
+            if (price_scale <= 0 || quantity_scale <= 0 || lot_size <= 0) {
+                throw std::invalid_argument("FixedPointConfig: price_scale, quantity_scale and lot_size must be > 0");
+            }
+        }
+
+        int64_t price_to_ticks(double price) const { return to_fixed(price, static_cast<double>(price_scale), "price"); }
+        double ticks_to_price(int64_t ticks) const { return static_cast<double>(ticks) / price_scale; }
+
+        int64_t quantity_to_units(double quantity) const {
+            return to_fixed(quantity, static_cast<double>(quantity_scale), "quantity");
+        }
+        double units_to_quantity(int64_t units) const { return static_cast<double>(units) / quantity_scale; }
+
+        int64_t cash_to_units(double cash) const {
+            return to_fixed(cash, static_cast<double>(price_scale) * quantity_scale, "cash");
+        }
+        double units_to_cash(int64_t units) const {
+            return static_cast<double>(units) / (static_cast<double>(price_scale) * quantity_scale);
+        }
+
+    private:
+        static int64_t to_fixed(double value, double scale, const char* what) {
+            if (!std::isfinite(value)) {
+                throw std::invalid_argument(std::string("FixedPointConfig: ") + what + " is not finite");
+            }
+            double scaled = value * scale;
+            // 2^63 is exact as a double; llround is only defined strictly inside (-2^63, 2^63)
+            if (!(std::fabs(scaled) < 9223372036854775808.0)) {
+                throw std::out_of_range(std::string("FixedPointConfig: ") + what + " does not fit in int64 at this scale");
+            }
+            return std::llround(scaled);
+        }
+    };
+
+    /**
+     * @brief a * b and a + b into `out`; return false instead of overflowing.
+     */
+    inline bool checked_mul(int64_t a, int64_t b, int64_t& out) {
+#if defined(__GNUC__) || defined(__clang__)
+        return !__builtin_mul_overflow(a, b, &out);
+#else
+        if (a != 0 && b != 0) {
+            if (a > 0 ? (b > 0 ? a > INT64_MAX / b : b < INT64_MIN / a)
+                      : (b > 0 ? a < INT64_MIN / b : a < INT64_MAX / b)) {
+                return false;
+            }
+        }
+        out = a * b;
+        return true;
+#endif
+    }
+
+    inline bool checked_add(int64_t a, int64_t b, int64_t& out) {
+#if defined(__GNUC__) || defined(__clang__)
+        return !__builtin_add_overflow(a, b, &out);
+#else
+        if ((b > 0 && a > INT64_MAX - b) || (b < 0 && a < INT64_MIN - b)) return false;
+        out = a + b;
+        return true;
+#endif
+    }
+
+    /**
+     * @brief floor(a * b / c) for non-negative a, b and b <= c (so the result fits).
+     */
+    inline int64_t mul_div_floor(int64_t a, int64_t b, int64_t c) {
+        // (a / c) * b <= a, so only the remainder term needs a wide product
+        int64_t head = (a / c) * b;
+        uint64_t r = static_cast<uint64_t>(a % c);
+        uint64_t divisor = static_cast<uint64_t>(c);
+#if defined(__SIZEOF_INT128__)
+        return head + static_cast<int64_t>(static_cast<unsigned __int128>(r) * static_cast<uint64_t>(b) / divisor);
+#else
+        // Shift-and-add r * b, keeping quotient and remainder (< divisor) separate
+        uint64_t q = 0, rem = 0;
+        for (int bit = 62; bit >= 0; --bit) {
+            q <<= 1;
+            rem <<= 1;
+            if (rem >= divisor) { rem -= divisor; ++q; }
+            if ((static_cast<uint64_t>(b) >> bit) & 1) {
+                rem += r;
+                if (rem >= divisor) { rem -= divisor; ++q; }
+            }
+        }
+        return head + static_cast<int64_t>(q);
+#endif
+    }
+
+} // namespace core
+} // namespace traider
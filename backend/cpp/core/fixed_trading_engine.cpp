@@ -0,0 +1,127 @@
+#include "fixed_trading_engine.h"
+#include <limits>
+
+namespace traider {
+namespace core {
+
+    namespace {
+
+        // Valuations saturate instead of wrapping when a book is too large for int64
+        int64_t saturating_add(int64_t a, int64_t b) {
+            int64_t out;
+            if (checked_add(a, b, out)) return out;
+            return b > 0 ? std::numeric_limits<int64_t>::max() : std::numeric_limits<int64_t>::min();
+        }
+
+        int64_t saturating_mul(int64_t a, int64_t b) {
+            int64_t out;
+            if (checked_mul(a, b, out)) return out;
+            return (a < 0) != (b < 0) ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max();
+        }
+
+    } // namespace
+
+    FixedTradingEngine::FixedTradingEngine(int64_t initial_cash, const FixedPointConfig& config)
+        : config_(config), cash_(initial_cash) {
+        config_.validate();
+    }
+
+    bool FixedTradingEngine::execute_trade(const std::string& ticker, int64_t quantity, int64_t price, OrderSide side) {
+        if (quantity <= 0 || price <= 0) return false;
+        if (config_.lot_size > 1 && quantity % config_.lot_size != 0) return false;
+
+        // Trades whose value or resulting balances do not fit in int64 are rejected
+        int64_t trade_value;
+        if (!checked_mul(quantity, price, trade_value)) return false;
+
+        if (side == OrderSide::BUY) {
+            if (cash_ < trade_value) return false;
+
+            auto existing = positions_.find(ticker);
+            int64_t new_quantity = quantity;
+            int64_t new_cost = trade_value;
+            if (existing != positions_.end() &&
+                (!checked_add(existing->second.quantity, quantity, new_quantity) ||
+                 !checked_add(existing->second.cost_basis, trade_value, new_cost))) {
+                return false;
+            }
+            cash_ -= trade_value;
+
+            auto& pos = positions_[ticker];
+            if (pos.quantity == 0) {
+                pos.ticker = ticker;
+                pos.current_price = price;
+            }
+            pos.quantity = new_quantity;
+            pos.cost_basis = new_cost;
+        } else {
+            auto it = positions_.find(ticker);
+            if (it == positions_.end() || it->second.quantity < quantity) return false;
+
+            FixedPosition& pos = it->second;
+            // Remove the sold share of the cost basis; a full close removes all of it
+            int64_t cost_removed = (quantity == pos.quantity)
+                ? pos.cost_basis
+                : mul_div_floor(pos.cost_basis, quantity, pos.quantity);
+
+            int64_t new_cash, new_realized;
+            if (!checked_add(cash_, trade_value, new_cash) ||
+                !checked_add(pos.realized_pnl, trade_value - cost_removed, new_realized)) {
+                return false;
+            }
+            cash_ = new_cash;
+            pos.realized_pnl = new_realized;
+            pos.cost_basis -= cost_removed;
+            pos.quantity -= quantity;
+
+            if (pos.quantity == 0) {
+                positions_.erase(it);
+            }
+        }
+
+        FixedOrder order;
+        order.ticker = ticker;
+        order.quantity = quantity;
+        order.price = price;
+        order.side = side;
+        order.type = OrderType::MARKET;
+        order.timestamp = 0;
+        trade_history_.push_back(order);
+        return true;
+    }
+
+    void FixedTradingEngine::update_price(const std::string& ticker, int64_t current_price) {
+        auto it = positions_.find(ticker);
+        if (it != positions_.end()) {
+            it->second.current_price = current_price;
+        }
+    }
+
+    int64_t FixedTradingEngine::get_cash() const {
+        return cash_;
+    }
+
+    int64_t FixedTradingEngine::get_portfolio_value() const {
+        int64_t value = cash_;
+        for (const auto& pair : positions_) {
+            value = saturating_add(value, saturating_mul(pair.second.quantity, pair.second.current_price));
+        }
+        return value;
+    }
+
+    int64_t FixedTradingEngine::get_unrealized_pnl(const std::string& ticker) const {
+        auto it = positions_.find(ticker);
+        if (it == positions_.end()) return 0;
+        return saturating_add(saturating_mul(it->second.quantity, it->second.current_price), -it->second.cost_basis);
+    }
+
+    const std::map<std::string, FixedPosition>& FixedTradingEngine::get_positions() const {
+        return positions_;
+    }
+
+    const std::vector<FixedOrder>& FixedTradingEngine::get_trade_history() const {
+        return trade_history_;
+    }
+
+} // namespace core
+} // namespace traider
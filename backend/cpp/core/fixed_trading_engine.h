@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "fixed_point.h"
+#include "trading_engine.h"
+
+namespace traider {
+namespace core {
+
+    struct FixedOrder {
+        std::string id;
+        std::string ticker;
+        OrderType type;
+        OrderSide side;
+        int64_t quantity; // Quantity units
+        int64_t price;    // Price ticks
+        int64_t timestamp;
+    };
+
+    struct FixedPosition {
+        std::string ticker;
+        int64_t quantity;      // Quantity units
+        int64_t cost_basis;    // Cash units paid for the open quantity
+        int64_t current_price; // Price ticks
+        int64_t realized_pnl;  // Cash units
+    };
+
+    /**
+     * @brief Integer counterpart of TradingEngine.
+     *
+     * Cash, positions and P&L are int64 so results are bit-identical across
+     * platforms and thread counts. Average price is derived from an exact cost
+     * basis instead of being re-averaged in floating point, and a position is
+     * closed exactly when its quantity reaches zero.
+     */
+    class FixedTradingEngine {
+    public:
+        FixedTradingEngine(int64_t initial_cash, const FixedPointConfig& config = FixedPointConfig());
+
+        // Returns false if the order was rejected (bad size, not a lot multiple, insufficient cash/shares)
+        bool execute_trade(const std::string& ticker, int64_t quantity, int64_t price, OrderSide side);
+        void update_price(const std::string& ticker, int64_t current_price);
+
+        int64_t get_cash() const;
+        int64_t get_portfolio_value() const;
+        int64_t get_unrealized_pnl(const std::string& ticker) const;
+        const std::map<std::string, FixedPosition>& get_positions() const;
+        const std::vector<FixedOrder>& get_trade_history() const;
+        const FixedPointConfig& get_config() const { return config_; }
+
+    private:
+        FixedPointConfig config_;
+        int64_t cash_;
+        std::map<std::string, FixedPosition> positions_;
+        std::vector<FixedOrder> trade_history_;
+    };
+
+} // namespace core
+} // namespace traider
@@ -0,0 +1,469 @@
+#include "bar_codec.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace traider {
+namespace data {
+
+    namespace {
+
+        // Largest magnitude a scaled value may have: scale_down converts exactly up to 2^51
+        constexpr double kMaxScaled = 2251799813685248.0; // 2^51
+        static_assert(CompressedBarSeries::kMaxBlockSize * kMaxScaled <= 9223372036854775808.0,
+                      "a full block's total_volume must fit in int64");
+
+        inline uint64_t zigzag(int64_t v) {
+            return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+        }
+
+        inline int64_t unzigzag(uint64_t v) {
+            return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+        }
+
+        inline void put_varint(std::vector<uint8_t>& out, uint64_t v) {
+            while (v >= 0x80) {
+                out.push_back(static_cast<uint8_t>(v) | 0x80);
+                v >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(v));
+        }
+
+        inline uint64_t get_varint(const uint8_t*& p) {
+            uint64_t v = 0;
+            int shift = 0;
+            while (true) {
+                uint8_t b = *p++;
+                v |= static_cast<uint64_t>(b & 0x7f) << shift;
+                if (!(b & 0x80)) return v;
+                shift += 7;
+            }
+        }
+
+        // Bytes of zero padding after a block so packed reads can always load 8 bytes
+        constexpr size_t kPadding = 8;
+
+        inline int bit_width(uint64_t v) {
+            int width = 0;
+            while (v) {
+                ++width;
+                v >>= 1;
+            }
+            return width;
+        }
+
+        // Frame-of-reference bit packing: one width byte, then every value in
+        // `width` bits. Unlike varints, unpacking has no data-dependent branches.
+        void put_packed(std::vector<uint8_t>& out, const std::vector<uint64_t>& values) {
+            uint64_t max_value = 0;
+            for (uint64_t v : values) max_value |= v;
+            int width = bit_width(max_value);
+            out.push_back(static_cast<uint8_t>(width));
+
+            size_t base = out.size();
+            size_t bytes = (values.size() * width + 7) / 8;
+            out.resize(base + bytes + kPadding, 0);
+            uint8_t* dst = out.data() + base;
+            for (size_t i = 0; i < values.size(); ++i) {
+                size_t bit = i * width;
+                uint64_t word;
+                std::memcpy(&word, dst + (bit >> 3), sizeof(word));
+                word |= values[i] << (bit & 7);
+                std::memcpy(dst + (bit >> 3), &word, sizeof(word));
+            }
+            out.resize(base + bytes);
+        }
+
+        inline void get_packed(const uint8_t* p, size_t n, int64_t* out) {
+            int width = *p++;
+            uint64_t mask = width == 0 ? 0 : (~uint64_t(0) >> (64 - width));
+            for (size_t i = 0; i < n; ++i) {
+                size_t bit = i * width;
+                uint64_t word;
+                std::memcpy(&word, p + (bit >> 3), sizeof(word));
+                out[i] = unzigzag((word >> (bit & 7)) & mask);
+            }
+        }
+
+        // Wrapping difference, so extreme timestamps cannot overflow signed arithmetic
+        inline int64_t wrap_sub(int64_t a, int64_t b) {
+            return static_cast<int64_t>(static_cast<uint64_t>(a) - static_cast<uint64_t>(b));
+        }
+
+        inline int64_t wrap_add(int64_t a, int64_t b) {
+            return static_cast<int64_t>(static_cast<uint64_t>(a) + static_cast<uint64_t>(b));
+        }
+
+        inline bool scalable(double v, double scale) {
+            return std::isfinite(v) && std::abs(v * scale) < kMaxScaled;
+        }
+
+        inline int64_t to_scaled(double v, double scale) {
+            return static_cast<int64_t>(std::llround(v * scale));
+        }
+
+        // int64 -> double without a conversion instruction (SSE2/AVX2 have none for
+        // 64-bit integers): adding v to the bits of 1.5 * 2^52 places it in the
+        // mantissa, exact for |v| <= 2^51. Straight-line and branch-free so the loop
+        // vectorizes; kept apart from the serial varint/prefix-sum loops.
+        constexpr double kMagic = 6755399441055744.0; // 1.5 * 2^52
+        constexpr int64_t kMagicBits = 0x4338000000000000LL;
+
+        inline void scale_down(const int64_t* in, double* out, size_t n, double scale) {
+            for (size_t i = 0; i < n; ++i) {
+                int64_t bits = in[i] + kMagicBits;
+                double d;
+                std::memcpy(&d, &bits, sizeof(d));
+                out[i] = (d - kMagic) / scale;
+            }
+        }
+
+    } // namespace
+
+    CompressedBarSeries::CompressedBarSeries(int price_decimals, int volume_decimals, size_t block_size)
+        : price_decimals_(std::max(0, std::min(price_decimals, 9))),
+          volume_decimals_(std::max(0, std::min(volume_decimals, 9))),
+          price_scale_(std::pow(10.0, price_decimals_)),
+          volume_scale_(std::pow(10.0, volume_decimals_)),
+          block_size_(std::max<size_t>(block_size, 1)) {
+        if (block_size_ > kMaxBlockSize) {
+            throw std::invalid_argument("CompressedBarSeries: block_size exceeds kMaxBlockSize");
+        }
+        tail_.reserve(block_size_);
+    }
+
+    bool CompressedBarSeries::append(const OHLCV& bar) {
+        if (!scalable(bar.open, price_scale_) || !scalable(bar.high, price_scale_) ||
+            !scalable(bar.low, price_scale_) || !scalable(bar.close, price_scale_) ||
+            !scalable(bar.volume, volume_scale_)) {
+            return false;
+        }
+
+        long long last_ts = std::numeric_limits<long long>::min();
+        if (!tail_.empty()) {
+            last_ts = tail_.back().timestamp;
+        } else if (!blocks_.empty()) {
+            last_ts = blocks_.back().summary.last_timestamp;
+        }
+        if (bar.timestamp < last_ts) return false;
+
+        // Round on the way in so the raw tail reads back the same as sealed blocks
+        OHLCV rounded = bar;
+        rounded.open = static_cast<double>(to_scaled(bar.open, price_scale_)) / price_scale_;
+        rounded.high = static_cast<double>(to_scaled(bar.high, price_scale_)) / price_scale_;
+        rounded.low = static_cast<double>(to_scaled(bar.low, price_scale_)) / price_scale_;
+        rounded.close = static_cast<double>(to_scaled(bar.close, price_scale_)) / price_scale_;
+        rounded.volume = static_cast<double>(to_scaled(bar.volume, volume_scale_)) / volume_scale_;
+        tail_.push_back(rounded);
+        if (tail_.size() >= block_size_) seal_tail();
+        return true;
+    }
+
+    size_t CompressedBarSeries::append(const std::vector<OHLCV>& bars) {
+        size_t accepted = 0;
+        for (const auto& bar : bars) {
+            if (append(bar)) ++accepted;
+        }
+        return accepted;
+    }
+
+    CompressedBarSeries CompressedBarSeries::encode(
+        const std::vector<OHLCV>& bars,
+        int price_decimals,
+        int volume_decimals,
+        size_t block_size
+    ) {
+        CompressedBarSeries series(price_decimals, volume_decimals, block_size);
+        series.append(bars);
+        return series;
+    }
+
+    void CompressedBarSeries::seal_tail() {
+        if (tail_.empty()) return;
+        size_t n = tail_.size();
+
+        std::vector<int64_t> close(n);
+        for (size_t i = 0; i < n; ++i) close[i] = to_scaled(tail_[i].close, price_scale_);
+
+        std::vector<uint8_t> buf;
+        buf.reserve(n * 8);
+
+        Block block;
+        BarBlockSummary& s = block.summary;
+        s.first_timestamp = tail_.front().timestamp;
+        s.last_timestamp = tail_.back().timestamp;
+        s.count = static_cast<uint32_t>(n);
+
+        // Timestamps: delta-of-delta
+        block.column_offsets[TIMESTAMP] = 0;
+        int64_t prev_ts = 0;
+        int64_t prev_delta = 0;
+        for (const auto& bar : tail_) {
+            int64_t delta = wrap_sub(bar.timestamp, prev_ts);
+            put_varint(buf, zigzag(wrap_sub(delta, prev_delta)));
+            prev_ts = bar.timestamp;
+            prev_delta = delta;
+        }
+
+        // Close: bit-packed deltas between consecutive bars
+        std::vector<uint64_t> packed(n);
+        block.column_offsets[CLOSE] = static_cast<uint32_t>(buf.size());
+        int64_t prev_close = 0;
+        int64_t min_close = close[0], max_close = close[0];
+        for (size_t i = 0; i < n; ++i) {
+            packed[i] = zigzag(close[i] - prev_close);
+            prev_close = close[i];
+            min_close = std::min(min_close, close[i]);
+            max_close = std::max(max_close, close[i]);
+        }
+        put_packed(buf, packed);
+
+        // Open/high/low: bit-packed offsets from the same bar's close
+        int64_t min_low = std::numeric_limits<int64_t>::max();
+        int64_t max_high = std::numeric_limits<int64_t>::min();
+        const Column offset_columns[] = {OPEN, HIGH, LOW};
+        for (Column column : offset_columns) {
+            block.column_offsets[column] = static_cast<uint32_t>(buf.size());
+            for (size_t i = 0; i < n; ++i) {
+                double price = column == OPEN ? tail_[i].open : (column == HIGH ? tail_[i].high : tail_[i].low);
+                int64_t scaled = to_scaled(price, price_scale_);
+                if (column == HIGH) max_high = std::max(max_high, scaled);
+                if (column == LOW) min_low = std::min(min_low, scaled);
+                packed[i] = zigzag(scaled - close[i]);
+            }
+            put_packed(buf, packed);
+        }
+
+        block.column_offsets[VOLUME] = static_cast<uint32_t>(buf.size());
+        int64_t total_volume = 0; // Bounded by kMaxBlockSize * kMaxScaled < 2^63
+        for (const auto& bar : tail_) {
+            int64_t volume = to_scaled(bar.volume, volume_scale_);
+            total_volume += volume;
+            put_varint(buf, zigzag(volume));
+        }
+        block.column_offsets[NUM_COLUMNS] = static_cast<uint32_t>(buf.size());
+
+        s.min_close = static_cast<double>(min_close) / price_scale_;
+        s.max_close = static_cast<double>(max_close) / price_scale_;
+        s.min_low = static_cast<double>(min_low) / price_scale_;
+        s.max_high = static_cast<double>(max_high) / price_scale_;
+        s.total_volume = static_cast<double>(total_volume) / volume_scale_;
+        s.compressed_bytes = static_cast<uint32_t>(buf.size());
+
+        buf.resize(buf.size() + kPadding, 0);
+        block.bytes.assign(buf.begin(), buf.end()); // Exact-size copy, no slack capacity
+        blocks_.push_back(std::move(block));
+        sealed_bars_ += n;
+        tail_.clear();
+    }
+
+    const BarBlockSummary& CompressedBarSeries::block_summary(size_t block) const {
+        if (block >= blocks_.size()) throw std::out_of_range("CompressedBarSeries: block index out of range");
+        return blocks_[block].summary;
+    }
+
+    size_t CompressedBarSeries::compressed_bytes() const {
+        size_t total = tail_.size() * sizeof(OHLCV);
+        for (const auto& block : blocks_) total += block.bytes.size() + sizeof(Block);
+        return total;
+    }
+
+    void CompressedBarSeries::decode_timestamps(const Block& block, std::vector<long long>& out) const {
+        size_t n = block.summary.count;
+        out.resize(n);
+        const uint8_t* p = block.bytes.data() + block.column_offsets[TIMESTAMP];
+        int64_t ts = 0;
+        int64_t delta = 0;
+        for (size_t i = 0; i < n; ++i) {
+            delta = wrap_add(delta, unzigzag(get_varint(p)));
+            ts = wrap_add(ts, delta);
+            out[i] = ts;
+        }
+    }
+
+    void CompressedBarSeries::decode_close_ints(const Block& block, std::vector<int64_t>& out) const {
+        size_t n = block.summary.count;
+        out.resize(n);
+        const uint8_t* p = block.bytes.data() + block.column_offsets[CLOSE];
+        get_packed(p, n, out.data());
+        for (size_t i = 1; i < n; ++i) out[i] += out[i - 1];
+    }
+
+    void CompressedBarSeries::decode_column_ints(
+        const Block& block,
+        Column column,
+        const std::vector<int64_t>& base,
+        std::vector<int64_t>& out
+    ) const {
+        size_t n = block.summary.count;
+        out.resize(n);
+        const uint8_t* p = block.bytes.data() + block.column_offsets[column];
+        if (column == VOLUME) {
+            for (size_t i = 0; i < n; ++i) out[i] = unzigzag(get_varint(p));
+        } else {
+            get_packed(p, n, out.data());
+        }
+        if (!base.empty()) {
+            for (size_t i = 0; i < n; ++i) out[i] += base[i];
+        }
+    }
+
+    void CompressedBarSeries::decode_block_into(
+        const Block& block,
+        DecodeScratch& scratch,
+        std::vector<OHLCV>& out,
+        size_t first,
+        size_t last,
+        bool timestamps_decoded
+    ) const {
+        if (first >= last) return;
+        size_t n = last - first;
+
+        // Column at a time into contiguous scratch columns: the scaling loops vectorize,
+        // and the bars are then written in a single interleaving pass
+        if (!timestamps_decoded) decode_timestamps(block, scratch.timestamps);
+        decode_close_ints(block, scratch.close_ints);
+        for (auto& column : scratch.values) column.resize(n);
+        scale_down(scratch.close_ints.data() + first, scratch.values[CLOSE].data(), n, price_scale_);
+
+        static const std::vector<int64_t> kNoBase;
+        const Column price_columns[] = {OPEN, HIGH, LOW};
+        for (Column column : price_columns) {
+            decode_column_ints(block, column, scratch.close_ints, scratch.ints);
+            scale_down(scratch.ints.data() + first, scratch.values[column].data(), n, price_scale_);
+        }
+        decode_column_ints(block, VOLUME, kNoBase, scratch.ints);
+        scale_down(scratch.ints.data() + first, scratch.values[VOLUME].data(), n, volume_scale_);
+
+        size_t base = out.size();
+        out.resize(base + n);
+        OHLCV* bars = out.data() + base;
+        const long long* timestamps = scratch.timestamps.data() + first;
+        const double* open = scratch.values[OPEN].data();
+        const double* high = scratch.values[HIGH].data();
+        const double* low = scratch.values[LOW].data();
+        const double* close = scratch.values[CLOSE].data();
+        const double* volume = scratch.values[VOLUME].data();
+        for (size_t i = 0; i < n; ++i) {
+            bars[i] = OHLCV{open[i], high[i], low[i], close[i], volume[i], timestamps[i]};
+        }
+    }
+
+    void CompressedBarSeries::decode_block(size_t block, std::vector<OHLCV>& out) const {
+        if (block >= blocks_.size()) return;
+        thread_local DecodeScratch scratch;
+        decode_block_into(blocks_[block], scratch, out, 0, blocks_[block].summary.count);
+    }
+
+    std::vector<OHLCV> CompressedBarSeries::decode() const {
+        std::vector<OHLCV> result;
+        result.reserve(size());
+        thread_local DecodeScratch scratch;
+        for (const auto& block : blocks_) {
+            decode_block_into(block, scratch, result, 0, block.summary.count);
+        }
+        result.insert(result.end(), tail_.begin(), tail_.end());
+        return result;
+    }
+
+    std::vector<OHLCV> CompressedBarSeries::decode_range(long long start_ts, long long end_ts) const {
+        std::vector<OHLCV> result;
+        if (start_ts > end_ts) return result;
+
+        thread_local DecodeScratch scratch;
+        for (const auto& block : blocks_) {
+            const BarBlockSummary& s = block.summary;
+            if (s.last_timestamp < start_ts) continue;
+            if (s.first_timestamp > end_ts) break;
+
+            size_t first = 0;
+            size_t last = s.count;
+            if (s.first_timestamp < start_ts || s.last_timestamp > end_ts) {
+                // Partially covered: locate the bounds on the timestamp column alone
+                decode_timestamps(block, scratch.timestamps);
+                const auto& ts = scratch.timestamps;
+                first = std::lower_bound(ts.begin(), ts.end(), start_ts) - ts.begin();
+                last = std::upper_bound(ts.begin(), ts.end(), end_ts) - ts.begin();
+                decode_block_into(block, scratch, result, first, last, true);
+                continue;
+            }
+            decode_block_into(block, scratch, result, first, last);
+        }
+
+        for (const auto& bar : tail_) {
+            if (bar.timestamp > end_ts) break;
+            if (bar.timestamp >= start_ts) result.push_back(bar);
+        }
+        return result;
+    }
+
+    std::vector<OHLCV> CompressedBarSeries::select_close_above(double threshold) const {
+        std::vector<OHLCV> result;
+        thread_local DecodeScratch scratch;
+        thread_local std::vector<OHLCV> block_bars;
+
+        for (const auto& block : blocks_) {
+            const BarBlockSummary& s = block.summary;
+            if (s.max_close <= threshold) continue; // Nothing in this block qualifies
+
+            if (s.min_close > threshold) {
+                decode_block_into(block, scratch, result, 0, s.count);
+                continue;
+            }
+
+            block_bars.clear();
+            decode_block_into(block, scratch, block_bars, 0, s.count);
+            for (const auto& bar : block_bars) {
+                if (bar.close > threshold) result.push_back(bar);
+            }
+        }
+
+        for (const auto& bar : tail_) {
+            if (bar.close > threshold) result.push_back(bar);
+        }
+        return result;
+    }
+
+    void CompressedBarSeries::decode_closes(
+        long long start_ts,
+        long long end_ts,
+        std::vector<long long>& timestamps,
+        std::vector<double>& closes
+    ) const {
+        timestamps.clear();
+        closes.clear();
+        if (start_ts > end_ts) return;
+
+        thread_local DecodeScratch scratch;
+        for (const auto& block : blocks_) {
+            const BarBlockSummary& s = block.summary;
+            if (s.last_timestamp < start_ts) continue;
+            if (s.first_timestamp > end_ts) break;
+
+            decode_timestamps(block, scratch.timestamps);
+            const auto& ts = scratch.timestamps;
+            size_t first = std::lower_bound(ts.begin(), ts.end(), start_ts) - ts.begin();
+            size_t last = std::upper_bound(ts.begin(), ts.end(), end_ts) - ts.begin();
+            if (first >= last) continue;
+
+            decode_close_ints(block, scratch.close_ints);
+            size_t base = closes.size();
+            closes.resize(base + (last - first));
+            scale_down(scratch.close_ints.data() + first, closes.data() + base, last - first, price_scale_);
+            timestamps.insert(timestamps.end(), ts.begin() + first, ts.begin() + last);
+        }
+
+        for (const auto& bar : tail_) {
+            if (bar.timestamp > end_ts) break;
+            if (bar.timestamp >= start_ts) {
+                timestamps.push_back(bar.timestamp);
+                closes.push_back(bar.close);
+            }
+        }
+    }
+
+} // namespace data
+} // namespace traider
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "data_processor.h"
+
+namespace traider {
+namespace data {
+
+    // Per-block summary used to skip blocks without decoding them. Prices are
+    // the decoded (rounded) values, so skipping decisions are exact.
+    struct BarBlockSummary {
+        long long first_timestamp;
+        long long last_timestamp;
+        double min_low;
+        double max_high;
+        double min_close;
+        double max_close;
+        double total_volume;
+        uint32_t count;
+        uint32_t compressed_bytes;
+    };
+
+    /**
+     * @brief Compressed columnar store for one series of OHLCV bars.
+     *
+     * Bars are sealed into fixed-size blocks. Inside a block every column is its
+     * own byte stream:
+     *  - timestamps: zigzag varint delta-of-delta (regular bars cost 1 byte)
+     *  - close: prices scaled to integers (10^price_decimals), zigzag deltas
+     *    bit-packed at the block's widest delta (branch-free to unpack)
+     *  - open/high/low: zigzag offsets from the same bar's close, bit-packed
+     *  - volume: scaled to integers (10^volume_decimals), zigzag varint
+     * Prices and volumes are rounded to their decimals on append; everything
+     * else round-trips exactly. The unsealed tail is kept raw until it fills.
+     */
+    class CompressedBarSeries {
+    public:
+        static constexpr size_t kDefaultBlockSize = 1024;
+        // Each scaled volume is below 2^51 in magnitude, so a block's int64
+        // total_volume cannot overflow below 2^12 bars
+        static constexpr size_t kMaxBlockSize = 4096;
+
+        // Throws std::invalid_argument if block_size > kMaxBlockSize (0 is treated as 1)
+        explicit CompressedBarSeries(
+            int price_decimals = 4,
+            int volume_decimals = 0,
+            size_t block_size = kDefaultBlockSize
+        );
+
+        // Bars must arrive in ascending timestamp order with finite prices/volume.
+        // @return false (and the bar is dropped) otherwise
+        bool append(const OHLCV& bar);
+        size_t append(const std::vector<OHLCV>& bars);
+
+        static CompressedBarSeries encode(
+            const std::vector<OHLCV>& bars,
+            int price_decimals = 4,
+            int volume_decimals = 0,
+            size_t block_size = kDefaultBlockSize
+        );
+
+        size_t size() const { return sealed_bars_ + tail_.size(); }
+        size_t num_blocks() const { return blocks_.size(); }
+        size_t block_size() const { return block_size_; }
+        int price_decimals() const { return price_decimals_; }
+        int volume_decimals() const { return volume_decimals_; }
+        // Throws std::out_of_range for block >= num_blocks()
+        const BarBlockSummary& block_summary(size_t block) const;
+
+        // Bytes held by sealed blocks plus the raw tail
+        size_t compressed_bytes() const;
+
+        // Appends block `block` to `out`
+        void decode_block(size_t block, std::vector<OHLCV>& out) const;
+
+        std::vector<OHLCV> decode() const;
+
+        /**
+         * @brief Bars with start_ts <= timestamp <= end_ts. Blocks outside the
+         * range (by summary) are skipped without decoding.
+         */
+        std::vector<OHLCV> decode_range(long long start_ts, long long end_ts) const;
+
+        /**
+         * @brief Bars with close > threshold. Blocks whose max_close <= threshold
+         * are skipped, and for those whose min_close > threshold every bar is taken
+         * without a per-bar test.
+         */
+        std::vector<OHLCV> select_close_above(double threshold) const;
+
+        /**
+         * @brief Decode only timestamp and close columns for start_ts <= t <= end_ts.
+         */
+        void decode_closes(
+            long long start_ts,
+            long long end_ts,
+            std::vector<long long>& timestamps,
+            std::vector<double>& closes
+        ) const;
+
+    private:
+        enum Column { TIMESTAMP = 0, CLOSE, OPEN, HIGH, LOW, VOLUME, NUM_COLUMNS };
+
+        struct Block {
+            BarBlockSummary summary;
+            uint32_t column_offsets[NUM_COLUMNS + 1];
+            std::vector<uint8_t> bytes;
+        };
+
+        // Scratch columns for one decoded block, kept per thread to avoid reallocation
+        struct DecodeScratch {
+            std::vector<long long> timestamps;
+            std::vector<int64_t> ints;
+            std::vector<int64_t> close_ints;
+            std::vector<double> values[NUM_COLUMNS]; // Scaled prices/volume by Column (TIMESTAMP unused)
+        };
+
+        void seal_tail();
+        void decode_timestamps(const Block& block, std::vector<long long>& out) const;
+        void decode_close_ints(const Block& block, std::vector<int64_t>& out) const;
+        void decode_column_ints(const Block& block, Column column, const std::vector<int64_t>& base,
+                                std::vector<int64_t>& out) const;
+        // Appends bars [first, last) of `block`; pass timestamps_decoded when
+        // scratch.timestamps already holds this block's timestamps
+        void decode_block_into(const Block& block, DecodeScratch& scratch, std::vector<OHLCV>& out,
+                               size_t first, size_t last, bool timestamps_decoded = false) const;
+
+        int price_decimals_;
+        int volume_decimals_;
+        double price_scale_;
+        double volume_scale_;
+        size_t block_size_;
+        size_t sealed_bars_ = 0;
+        std::vector<Block> blocks_;
+        std::vector<OHLCV> tail_;
+    };
+
+} // namespace data
+} // namespace traider
@@ -1,6 +1,10 @@
 #include "data_processor.h"
 #include <algorithm>
+#include <functional>
 #include <limits>
+#include <queue>
+#include <stdexcept>
+#include <string>
 
 namespace traider {
 namespace data {
@@ -72,6 +76,109 @@ namespace data {
         return result;
     }
 
+    namespace {
+        void check_series(const AlignedMatrix& m, size_t series) {
+            if (series >= m.num_series) throw std::out_of_range("AlignedMatrix: series index out of range");
+        }
+    } // namespace
+
+    double AlignedMatrix::at(size_t row, size_t series) const {
+        check_series(*this, series);
+        if (row >= num_rows()) throw std::out_of_range("AlignedMatrix: row index out of range");
+        return values[series * timestamps.size() + row];
+    }
+
+    std::vector<double> AlignedMatrix::column(size_t series) const {
+        check_series(*this, series);
+        auto begin = values.begin() + series * timestamps.size();
+        return std::vector<double>(begin, begin + timestamps.size());
+    }
+
+    std::vector<uint8_t> AlignedMatrix::valid_column(size_t series) const {
+        check_series(*this, series);
+        auto begin = valid.begin() + series * timestamps.size();
+        return std::vector<uint8_t>(begin, begin + timestamps.size());
+    }
+
+    AlignedMatrix DataProcessor::align_asof(
+        const std::vector<std::vector<long long>>& timestamps,
+        const std::vector<std::vector<double>>& values,
+        const std::vector<long long>& calendar,
+        bool forward_fill,
+        long long tolerance
+    ) {
+        AlignedMatrix result;
+        size_t k = std::min(timestamps.size(), values.size());
+        result.num_series = k;
+
+        // Both the merge and the monotone fill assume sorted input; unsorted input would misalign silently
+        for (size_t s = 0; s < k; ++s) {
+            if (!std::is_sorted(timestamps[s].begin(), timestamps[s].end())) {
+                throw std::invalid_argument("align_asof: timestamps of series " + std::to_string(s) +
+                                            " are not sorted ascending");
+            }
+        }
+        if (!std::is_sorted(calendar.begin(), calendar.end())) {
+            throw std::invalid_argument("align_asof: calendar is not sorted ascending");
+        }
+
+        if (!calendar.empty()) {
+            result.timestamps = calendar;
+        } else {
+            // k-way merge of the sorted inputs into a de-duplicated union calendar
+            using Head = std::pair<long long, size_t>; // {timestamp, series}
+            std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heap;
+            std::vector<size_t> cursor(k, 0);
+            size_t total = 0;
+            for (size_t s = 0; s < k; ++s) {
+                size_t n = std::min(timestamps[s].size(), values[s].size());
+                total += n;
+                if (n > 0) heap.emplace(timestamps[s][0], s);
+            }
+            result.timestamps.reserve(total);
+
+            while (!heap.empty()) {
+                Head head = heap.top();
+                heap.pop();
+                if (result.timestamps.empty() || result.timestamps.back() != head.first) {
+                    result.timestamps.push_back(head.first);
+                }
+                size_t s = head.second;
+                size_t n = std::min(timestamps[s].size(), values[s].size());
+                if (++cursor[s] < n) heap.emplace(timestamps[s][cursor[s]], s);
+            }
+        }
+
+        size_t rows = result.timestamps.size();
+        result.values.assign(rows * k, std::numeric_limits<double>::quiet_NaN());
+        result.valid.assign(rows * k, 0);
+
+        for (size_t s = 0; s < k; ++s) {
+            const auto& ts = timestamps[s];
+            const auto& vs = values[s];
+            size_t n = std::min(ts.size(), vs.size());
+            double* out = result.values.data() + s * rows;
+            uint8_t* mask = result.valid.data() + s * rows;
+
+            // Monotone cursor: `c` is one past the latest observation at or before the row
+            size_t c = 0;
+            for (size_t r = 0; r < rows; ++r) {
+                long long t = result.timestamps[r];
+                while (c < n && ts[c] <= t) ++c;
+                if (c == 0) continue; // No observation yet
+
+                size_t last = c - 1;
+                bool exact = ts[last] == t;
+                bool fresh = tolerance < 0 || t - ts[last] <= tolerance;
+                if (exact || (forward_fill && fresh)) {
+                    out[r] = vs[last];
+                    mask[r] = 1;
+                }
+            }
+        }
+
+        return result;
+    }
+
 } // namespace data
 } // namespace traider
-
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
 
 namespace traider {
 namespace data {
@@ -15,6 +16,21 @@ namespace data {
         long long timestamp; // Unix timestamp
     };
 
+    // N series aligned onto one calendar. Column-major: series s occupies
+    // values[s * num_rows, (s + 1) * num_rows), so each column is contiguous.
+    struct AlignedMatrix {
+        std::vector<long long> timestamps; // Row calendar
+        size_t num_series = 0;
+        std::vector<double> values;        // NaN where invalid
+        std::vector<uint8_t> valid;        // 1 if the cell holds an exact or in-tolerance as-of value
+
+        size_t num_rows() const { return timestamps.size(); }
+        // Accessors throw std::out_of_range for series >= num_series or row >= num_rows()
+        double at(size_t row, size_t series) const;
+        std::vector<double> column(size_t series) const;
+        std::vector<uint8_t> valid_column(size_t series) const;
+    };
+
     class DataProcessor {
     public:
         // Convert raw parallel arrays to OHLCV struct
@@ -32,6 +48,26 @@ namespace data {
 
         // Normalize data (min-max scaling)
         static std::vector<double> normalize(const std::vector<double>& data);
+
+        /**
+         * @brief As-of join of N timestamped series onto one calendar
+         * @param timestamps Per-series timestamps, each sorted ascending
+         * @param values Per-series values, parallel to timestamps
+         * @param calendar Row timestamps (sorted); empty = union of all series timestamps
+         * @param forward_fill Carry the last observation forward when a series has no row at t
+         * @param tolerance Max age (timestamp units) of a carried value; < 0 = unlimited.
+         *        Only applies when forward-filling: exact matches are always kept.
+         * @return Column-major matrix with validity mask. Union calendar is built by a
+         *         k-way merge (O(N log k)); each column is filled in one monotone pass.
+         * @throws std::invalid_argument if a series or the calendar is not sorted ascending
+         */
+        static AlignedMatrix align_asof(
+            const std::vector<std::vector<long long>>& timestamps,
+            const std::vector<std::vector<double>>& values,
+            const std::vector<long long>& calendar = {},
+            bool forward_fill = true,
+            long long tolerance = -1
+        );
     };
 
 } // namespace data
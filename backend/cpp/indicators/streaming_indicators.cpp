@@ -0,0 +1,93 @@
+#include "streaming_indicators.h"
+#include <algorithm>
+#include <limits>
+
+namespace traider {
+namespace indicators {
+
+    namespace {
+        constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    StreamingSMA::StreamingSMA(int period)
+        : period_(period < 1 ? 1 : period), window_(static_cast<size_t>(period_), 0.0) {}
+
+    double StreamingSMA::update(double price) {
+        size_t slot = count_ % period_;
+        sum_ += price - window_[slot];
+        window_[slot] = price;
+        ++count_;
+        if (count_ < static_cast<size_t>(period_)) return kNaN;
+        return sum_ / period_;
+    }
+
+    void StreamingSMA::reset() {
+        std::fill(window_.begin(), window_.end(), 0.0);
+        count_ = 0;
+        sum_ = 0.0;
+    }
+
+    StreamingEMA::StreamingEMA(int period)
+        : period_(period < 1 ? 1 : period), multiplier_(2.0 / (period_ + 1.0)) {}
+
+    double StreamingEMA::update(double price) {
+        ++count_;
+        if (count_ < static_cast<size_t>(period_)) {
+            sum_ += price;
+            return kNaN;
+        }
+        if (count_ == static_cast<size_t>(period_)) {
+            value_ = (sum_ + price) / period_;
+            return value_;
+        }
+        value_ = (price - value_) * multiplier_ + value_;
+        return value_;
+    }
+
+    void StreamingEMA::reset() {
+        count_ = 0;
+        sum_ = 0.0;
+        value_ = 0.0;
+    }
+
+    StreamingRSI::StreamingRSI(int period) : period_(period < 1 ? 1 : period) {}
+
+    double StreamingRSI::update(double price) {
+        if (count_++ == 0) {
+            prev_price_ = price;
+            return kNaN;
+        }
+
+        double change = price - prev_price_;
+        prev_price_ = price;
+        double gain = change > 0 ? change : 0.0;
+        double loss = change < 0 ? -change : 0.0;
+        size_t changes = count_ - 1;
+
+        if (changes < static_cast<size_t>(period_)) {
+            avg_gain_ += gain;
+            avg_loss_ += loss;
+            return kNaN;
+        }
+        if (changes == static_cast<size_t>(period_)) {
+            // Seed with the simple average of the first `period` changes
+            avg_gain_ = (avg_gain_ + gain) / period_;
+            avg_loss_ = (avg_loss_ + loss) / period_;
+        } else {
+            avg_gain_ = (avg_gain_ * (period_ - 1) + gain) / period_;
+            avg_loss_ = (avg_loss_ * (period_ - 1) + loss) / period_;
+        }
+
+        double rs = (avg_loss_ == 0) ? 100.0 : avg_gain_ / avg_loss_;
+        return 100.0 - (100.0 / (1.0 + rs));
+    }
+
+    void StreamingRSI::reset() {
+        count_ = 0;
+        prev_price_ = 0.0;
+        avg_gain_ = 0.0;
+        avg_loss_ = 0.0;
+    }
+
+} // namespace indicators
+} // namespace traider
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace traider {
+namespace indicators {
+
+    // Incremental counterparts of the batch indicators in technical_indicators.h.
+    // Each update() consumes one price and returns the value the batch function
+    // would produce at that index (NaN during warm-up). O(1) per update.
+
+    class StreamingSMA {
+    public:
+        explicit StreamingSMA(int period);
+        double update(double price);
+        void reset();
+
+    private:
+        int period_;
+        std::vector<double> window_;
+        size_t count_ = 0;
+        double sum_ = 0.0;
+    };
+
+    /**
+     * @brief EMA seeded with the SMA of the first `period` prices. Matches the batch
+     * ema() once at least `period` prices exist; the batch short-history fallback
+     * cannot be reproduced without knowing the final length.
+     */
+    class StreamingEMA {
+    public:
+        explicit StreamingEMA(int period);
+        double update(double price);
+        void reset();
+
+    private:
+        int period_;
+        double multiplier_;
+        size_t count_ = 0;
+        double sum_ = 0.0;
+        double value_ = 0.0;
+    };
+
+    class StreamingRSI {
+    public:
+        explicit StreamingRSI(int period = 14);
+        double update(double price);
+        void reset();
+
+    private:
+        int period_;
+        size_t count_ = 0;
+        double prev_price_ = 0.0;
+        double avg_gain_ = 0.0;
+        double avg_loss_ = 0.0;
+    };
+
+} // namespace indicators
+} // namespace traider
@@ -4,29 +4,90 @@
 #include "utils/math_utils.h"
 #include "indicators/technical_indicators.h"
 #include "core/trading_engine.h"
+#include "core/fixed_trading_engine.h"
 #include "data/data_processor.h"
+#include "data/bar_codec.h"
 #include "portfolio/portfolio_analytics.h"
 #include "backtesting/backtest_engine.h"
+#include "metrics/instrumentation.h"
+#include "accounts/account_manager.h"
+#include "replay/replay_engine.h"
+#include "risk/risk_engine.h"
+#include "pricing/black_scholes.h"
+#include "pricing/lattice.h"
 
 namespace py = pybind11;
 
+namespace {
+
+    // Bytes of input handed to a bound function, reported per probe.
+    template <typename T>
+    uint64_t payload_bytes(const std::vector<T>& v) { return v.size() * sizeof(T); }
+    template <typename T>
+    uint64_t payload_bytes(const std::vector<std::vector<T>>& v) {
+        // Count the elements of each row, not the row headers
+        uint64_t bytes = 0;
+        for (const auto& row : v) bytes += payload_bytes(row);
+        return bytes;
+    }
+    uint64_t payload_bytes(const std::string& s) { return s.size(); }
+    template <typename T>
+    uint64_t payload_bytes(const T&) { return 0; }
+
+    template <typename... Args>
+    uint64_t total_payload(const Args&... args) { return (uint64_t{0} + ... + payload_bytes(args)); }
+
+    // Wrap a bound function so each call is timed under `name` when metrics are enabled.
+    // Argument conversion happens before the wrapper runs, so the probe covers the C++ work only.
+    template <typename R, typename... Args>
+    auto instrumented(const char* name, R (*fn)(Args...)) {
+        int probe = traider::metrics::register_probe(name);
+        return [probe, fn](Args... args) -> R {
+            traider::metrics::ScopedTimer timer(probe);
+            if (timer.active()) timer.add_bytes(total_payload(args...));
+            return fn(std::forward<Args>(args)...);
+        };
+    }
+
+    template <typename R, typename C, typename... Args>
+    auto instrumented(const char* name, R (C::*fn)(Args...)) {
+        int probe = traider::metrics::register_probe(name);
+        return [probe, fn](C& self, Args... args) -> R {
+            traider::metrics::ScopedTimer timer(probe);
+            if (timer.active()) timer.add_bytes(total_payload(args...));
+            return (self.*fn)(std::forward<Args>(args)...);
+        };
+    }
+
+    template <typename R, typename C, typename... Args>
+    auto instrumented(const char* name, R (C::*fn)(Args...) const) {
+        int probe = traider::metrics::register_probe(name);
+        return [probe, fn](const C& self, Args... args) -> R {
+            traider::metrics::ScopedTimer timer(probe);
+            if (timer.active()) timer.add_bytes(total_payload(args...));
+            return (self.*fn)(std::forward<Args>(args)...);
+        };
+    }
+
+} // namespace
+
 PYBIND11_MODULE(traider_cpp, m) {
     m.doc() = "High-performance C++ trading engine for Traider";
 
     // --- Utils Module ---
     auto m_utils = m.def_submodule("utils", "Mathematical utility functions");
-    m_utils.def("mean", &traider::utils::mean, "Calculate mean of a vector");
-    m_utils.def("variance", &traider::utils::variance, "Calculate variance of a vector");
-    m_utils.def("std_dev", &traider::utils::std_dev, "Calculate standard deviation of a vector");
-    m_utils.def("pct_change", &traider::utils::pct_change, "Calculate percentage change");
+    m_utils.def("mean", instrumented("utils.mean", &traider::utils::mean), "Calculate mean of a vector");
+    m_utils.def("variance", instrumented("utils.variance", &traider::utils::variance), "Calculate variance of a vector");
+    m_utils.def("std_dev", instrumented("utils.std_dev", &traider::utils::std_dev), "Calculate standard deviation of a vector");
+    m_utils.def("pct_change", instrumented("utils.pct_change", &traider::utils::pct_change), "Calculate percentage change");
 
     // --- Indicators Module ---
     auto m_indicators = m.def_submodule("indicators", "Technical indicators");
-    m_indicators.def("sma", &traider::indicators::sma, "Calculate Simple Moving Average", py::arg("prices"), py::arg("period"));
-    m_indicators.def("ema", &traider::indicators::ema, "Calculate Exponential Moving Average", py::arg("prices"), py::arg("period"));
-    m_indicators.def("rsi", &traider::indicators::rsi, "Calculate RSI", py::arg("prices"), py::arg("period") = 14);
-    m_indicators.def("vwap", &traider::indicators::vwap, "Calculate VWAP", py::arg("prices"), py::arg("volumes"));
-    m_indicators.def("bollinger_bands", &traider::indicators::bollinger_bands, "Calculate Bollinger Bands", py::arg("prices"), py::arg("period") = 20, py::arg("num_std_dev") = 2.0);
+    m_indicators.def("sma", instrumented("indicators.sma", &traider::indicators::sma), "Calculate Simple Moving Average", py::arg("prices"), py::arg("period"));
+    m_indicators.def("ema", instrumented("indicators.ema", &traider::indicators::ema), "Calculate Exponential Moving Average", py::arg("prices"), py::arg("period"));
+    m_indicators.def("rsi", instrumented("indicators.rsi", &traider::indicators::rsi), "Calculate RSI", py::arg("prices"), py::arg("period") = 14);
+    m_indicators.def("vwap", instrumented("indicators.vwap", &traider::indicators::vwap), "Calculate VWAP", py::arg("prices"), py::arg("volumes"));
+    m_indicators.def("bollinger_bands", instrumented("indicators.bollinger_bands", &traider::indicators::bollinger_bands), "Calculate Bollinger Bands", py::arg("prices"), py::arg("period") = 20, py::arg("num_std_dev") = 2.0);
 
     // --- Data Module ---
     auto m_data = m.def_submodule("data", "Data processing utilities");
@@ -39,7 +100,62 @@ PYBIND11_MODULE(traider_cpp, m) {
         .def_readwrite("volume", &traider::data::OHLCV::volume)
         .def_readwrite("timestamp", &traider::data::OHLCV::timestamp);
 
-    m_data.def("normalize", &traider::data::DataProcessor::normalize, "Normalize data (min-max)");
+    m_data.def("normalize", instrumented("data.normalize", &traider::data::DataProcessor::normalize), "Normalize data (min-max)");
+
+    py::class_<traider::data::AlignedMatrix>(m_data, "AlignedMatrix")
+        .def(py::init<>())
+        .def_readonly("timestamps", &traider::data::AlignedMatrix::timestamps)
+        .def_readonly("num_series", &traider::data::AlignedMatrix::num_series)
+        .def_readonly("values", &traider::data::AlignedMatrix::values)
+        .def_readonly("valid", &traider::data::AlignedMatrix::valid)
+        .def("num_rows", &traider::data::AlignedMatrix::num_rows)
+        .def("at", &traider::data::AlignedMatrix::at)
+        .def("column", &traider::data::AlignedMatrix::column)
+        .def("valid_column", &traider::data::AlignedMatrix::valid_column);
+
+    m_data.def("align_asof", instrumented("data.align_asof", &traider::data::DataProcessor::align_asof),
+        "As-of join of N timestamped series onto a union (empty calendar) or reference calendar",
+        py::arg("timestamps"), py::arg("values"), py::arg("calendar") = std::vector<long long>(),
+        py::arg("forward_fill") = true, py::arg("tolerance") = -1);
+
+    py::class_<traider::data::BarBlockSummary>(m_data, "BarBlockSummary")
+        .def(py::init<>())
+        .def_readonly("first_timestamp", &traider::data::BarBlockSummary::first_timestamp)
+        .def_readonly("last_timestamp", &traider::data::BarBlockSummary::last_timestamp)
+        .def_readonly("min_low", &traider::data::BarBlockSummary::min_low)
+        .def_readonly("max_high", &traider::data::BarBlockSummary::max_high)
+        .def_readonly("min_close", &traider::data::BarBlockSummary::min_close)
+        .def_readonly("max_close", &traider::data::BarBlockSummary::max_close)
+        .def_readonly("total_volume", &traider::data::BarBlockSummary::total_volume)
+        .def_readonly("count", &traider::data::BarBlockSummary::count)
+        .def_readonly("compressed_bytes", &traider::data::BarBlockSummary::compressed_bytes);
+
+    py::class_<traider::data::CompressedBarSeries>(m_data, "CompressedBarSeries")
+        .def(py::init<int, int, size_t>(),
+            py::arg("price_decimals") = 4, py::arg("volume_decimals") = 0,
+            py::arg("block_size") = traider::data::CompressedBarSeries::kDefaultBlockSize)
+        .def_static("encode", instrumented("data.CompressedBarSeries.encode", &traider::data::CompressedBarSeries::encode),
+            py::arg("bars"), py::arg("price_decimals") = 4, py::arg("volume_decimals") = 0,
+            py::arg("block_size") = traider::data::CompressedBarSeries::kDefaultBlockSize)
+        .def("append", py::overload_cast<const traider::data::OHLCV&>(&traider::data::CompressedBarSeries::append))
+        .def("append_many", py::overload_cast<const std::vector<traider::data::OHLCV>&>(&traider::data::CompressedBarSeries::append))
+        .def("size", &traider::data::CompressedBarSeries::size)
+        .def("num_blocks", &traider::data::CompressedBarSeries::num_blocks)
+        .def("block_summary", &traider::data::CompressedBarSeries::block_summary)
+        .def("compressed_bytes", &traider::data::CompressedBarSeries::compressed_bytes)
+        .def("decode", instrumented("data.CompressedBarSeries.decode", &traider::data::CompressedBarSeries::decode))
+        .def("decode_range", instrumented("data.CompressedBarSeries.decode_range", &traider::data::CompressedBarSeries::decode_range),
+            py::arg("start_ts"), py::arg("end_ts"))
+        .def("select_close_above", instrumented("data.CompressedBarSeries.select_close_above", &traider::data::CompressedBarSeries::select_close_above),
+            py::arg("threshold"))
+        .def("decode_closes", [](const traider::data::CompressedBarSeries& self, long long start_ts, long long end_ts) {
+                std::vector<long long> timestamps;
+                std::vector<double> closes;
+                self.decode_closes(start_ts, end_ts, timestamps, closes);
+                return py::make_tuple(timestamps, closes);
+            },
+            "Decode only (timestamps, closes) for start_ts <= t <= end_ts",
+            py::arg("start_ts"), py::arg("end_ts"));
 
     // --- Core Module ---
     auto m_core = m.def_submodule("core", "Core trading engine components");
@@ -60,11 +176,44 @@ PYBIND11_MODULE(traider_cpp, m) {
 
     py::class_<traider::core::TradingEngine>(m_core, "TradingEngine")
         .def(py::init<double>())
-        .def("execute_trade", &traider::core::TradingEngine::execute_trade)
-        .def("update_price", &traider::core::TradingEngine::update_price)
-        .def("get_capital", &traider::core::TradingEngine::get_capital)
-        .def("get_portfolio_value", &traider::core::TradingEngine::get_portfolio_value)
-        .def("get_positions", &traider::core::TradingEngine::get_positions);
+        .def("execute_trade", instrumented("core.TradingEngine.execute_trade", &traider::core::TradingEngine::execute_trade))
+        .def("update_price", instrumented("core.TradingEngine.update_price", &traider::core::TradingEngine::update_price))
+        .def("get_capital", instrumented("core.TradingEngine.get_capital", &traider::core::TradingEngine::get_capital))
+        .def("get_portfolio_value", instrumented("core.TradingEngine.get_portfolio_value", &traider::core::TradingEngine::get_portfolio_value))
+        .def("get_positions", instrumented("core.TradingEngine.get_positions", &traider::core::TradingEngine::get_positions));
+
+    // Fixed-point mode: int64 ticks/units. Use FixedPointConfig to convert at the boundary.
+    py::class_<traider::core::FixedPointConfig>(m_core, "FixedPointConfig")
+        .def(py::init<int64_t, int64_t, int64_t>(),
+            py::arg("price_scale") = 10000, py::arg("quantity_scale") = 1, py::arg("lot_size") = 1)
+        .def_readonly("price_scale", &traider::core::FixedPointConfig::price_scale)
+        .def_readonly("quantity_scale", &traider::core::FixedPointConfig::quantity_scale)
+        .def_readonly("lot_size", &traider::core::FixedPointConfig::lot_size)
+        .def("price_to_ticks", &traider::core::FixedPointConfig::price_to_ticks)
+        .def("ticks_to_price", &traider::core::FixedPointConfig::ticks_to_price)
+        .def("quantity_to_units", &traider::core::FixedPointConfig::quantity_to_units)
+        .def("units_to_quantity", &traider::core::FixedPointConfig::units_to_quantity)
+        .def("cash_to_units", &traider::core::FixedPointConfig::cash_to_units)
+        .def("units_to_cash", &traider::core::FixedPointConfig::units_to_cash);
+
+    py::class_<traider::core::FixedPosition>(m_core, "FixedPosition")
+        .def(py::init<>())
+        .def_readwrite("ticker", &traider::core::FixedPosition::ticker)
+        .def_readwrite("quantity", &traider::core::FixedPosition::quantity)
+        .def_readwrite("cost_basis", &traider::core::FixedPosition::cost_basis)
+        .def_readwrite("current_price", &traider::core::FixedPosition::current_price)
+        .def_readwrite("realized_pnl", &traider::core::FixedPosition::realized_pnl);
+
+    py::class_<traider::core::FixedTradingEngine>(m_core, "FixedTradingEngine")
+        .def(py::init<int64_t, const traider::core::FixedPointConfig&>(),
+            py::arg("initial_cash"), py::arg("config") = traider::core::FixedPointConfig())
+        .def("execute_trade", instrumented("core.FixedTradingEngine.execute_trade", &traider::core::FixedTradingEngine::execute_trade))
+        .def("update_price", instrumented("core.FixedTradingEngine.update_price", &traider::core::FixedTradingEngine::update_price))
+        .def("get_cash", &traider::core::FixedTradingEngine::get_cash)
+        .def("get_portfolio_value", &traider::core::FixedTradingEngine::get_portfolio_value)
+        .def("get_unrealized_pnl", &traider::core::FixedTradingEngine::get_unrealized_pnl)
+        .def("get_positions", &traider::core::FixedTradingEngine::get_positions)
+        .def("get_config", &traider::core::FixedTradingEngine::get_config);
 
     // --- Backtesting Module ---
     auto m_backtest = m.def_submodule("backtesting", "Backtesting engine");
@@ -77,7 +226,7 @@ PYBIND11_MODULE(traider_cpp, m) {
         .def_readwrite("max_drawdown", &traider::portfolio::PortfolioMetrics::max_drawdown)
         .def_readwrite("volatility", &traider::portfolio::PortfolioMetrics::volatility);
 
-    m_backtest.def("calculate_metrics", &traider::portfolio::PortfolioAnalytics::calculate_metrics,
+    m_backtest.def("calculate_metrics", instrumented("portfolio.calculate_metrics", &traider::portfolio::PortfolioAnalytics::calculate_metrics),
         "Calculate portfolio metrics from equity curve",
         py::arg("equity_curve"), py::arg("risk_free_rate") = 0.02);
 
@@ -86,8 +235,261 @@ PYBIND11_MODULE(traider_cpp, m) {
         .def_readwrite("metrics", &traider::backtesting::BacktestResult::metrics)
         .def_readwrite("equity_curve", &traider::backtesting::BacktestResult::equity_curve);
 
+    py::class_<traider::backtesting::TradeRecord>(m_backtest, "TradeRecord")
+        .def(py::init<>())
+        .def_readwrite("bar", &traider::backtesting::TradeRecord::bar)
+        .def_readwrite("side", &traider::backtesting::TradeRecord::side)
+        .def_readwrite("quantity", &traider::backtesting::TradeRecord::quantity)
+        .def_readwrite("price", &traider::backtesting::TradeRecord::price);
+
+    py::class_<traider::backtesting::BacktestWorkspace>(m_backtest, "BacktestWorkspace")
+        .def(py::init<>())
+        .def(py::init<size_t, size_t>(), py::arg("expected_bars"), py::arg("expected_trades"))
+        .def("reset", &traider::backtesting::BacktestWorkspace::reset)
+        .def("reserve", &traider::backtesting::BacktestWorkspace::reserve)
+        .def("equity_curve", &traider::backtesting::BacktestWorkspace::equity_curve)
+        .def("trades", &traider::backtesting::BacktestWorkspace::trades)
+        .def("metrics", &traider::backtesting::BacktestWorkspace::metrics)
+        .def("growth_count", &traider::backtesting::BacktestWorkspace::growth_count);
+
     py::class_<traider::backtesting::BacktestEngine>(m_backtest, "BacktestEngine")
         .def(py::init<double>())
-        .def("run_simple", &traider::backtesting::BacktestEngine::run_simple);
+        .def("run_simple", instrumented("backtesting.BacktestEngine.run_simple", &traider::backtesting::BacktestEngine::run_simple))
+        .def("run_simple_fixed", instrumented("backtesting.BacktestEngine.run_simple_fixed", &traider::backtesting::BacktestEngine::run_simple_fixed),
+            py::arg("ticker"), py::arg("prices"), py::arg("signals"),
+            py::arg("config") = traider::core::FixedPointConfig())
+        .def("run_simple_into", instrumented("backtesting.BacktestEngine.run_simple_into", &traider::backtesting::BacktestEngine::run_simple_into),
+            py::arg("prices"), py::arg("signals"), py::arg("workspace"))
+        .def("run_simple_sweep", instrumented("backtesting.BacktestEngine.run_simple_sweep",
+                py::overload_cast<const std::vector<double>&, const std::vector<std::vector<int>>&, size_t>(
+                    &traider::backtesting::BacktestEngine::run_simple_sweep, py::const_)),
+            "Run one backtest per signal set in parallel and return their metrics",
+            py::arg("prices"), py::arg("signal_sets"), py::arg("num_threads") = 0,
+            py::call_guard<py::gil_scoped_release>());
+
+    // --- Pricing Module ---
+    auto m_pricing = m.def_submodule("pricing", "Options pricing, Greeks and implied volatility");
+
+    py::enum_<traider::pricing::LatticeModel>(m_pricing, "LatticeModel")
+        .value("BINOMIAL", traider::pricing::LatticeModel::BINOMIAL)
+        .value("TRINOMIAL", traider::pricing::LatticeModel::TRINOMIAL)
+        .export_values();
+
+    py::class_<traider::pricing::GreeksResult>(m_pricing, "GreeksResult")
+        .def(py::init<>())
+        .def_readwrite("price", &traider::pricing::GreeksResult::price)
+        .def_readwrite("delta", &traider::pricing::GreeksResult::delta)
+        .def_readwrite("gamma", &traider::pricing::GreeksResult::gamma)
+        .def_readwrite("vega", &traider::pricing::GreeksResult::vega)
+        .def_readwrite("theta", &traider::pricing::GreeksResult::theta)
+        .def_readwrite("rho", &traider::pricing::GreeksResult::rho);
+
+    m_pricing.def("bsm_price", instrumented("pricing.bsm_price", &traider::pricing::bsm_price), "Black-Scholes-Merton price of one option",
+        py::arg("spot"), py::arg("strike"), py::arg("time_to_expiry"), py::arg("volatility"),
+        py::arg("is_call"), py::arg("rate"), py::arg("dividend_yield") = 0.0);
+    m_pricing.def("bsm_price_batch", instrumented("pricing.bsm_price_batch", &traider::pricing::bsm_price_batch),
+        "Batch Black-Scholes-Merton prices",
+        py::arg("spots"), py::arg("strikes"), py::arg("times"), py::arg("volatilities"), py::arg("is_call"),
+        py::arg("rate"), py::arg("dividend_yields") = std::vector<double>(), py::arg("num_threads") = 0,
+        py::call_guard<py::gil_scoped_release>());
+    m_pricing.def("bsm_greeks_batch", instrumented("pricing.bsm_greeks_batch", &traider::pricing::bsm_greeks_batch),
+        "Batch Black-Scholes-Merton prices and Greeks",
+        py::arg("spots"), py::arg("strikes"), py::arg("times"), py::arg("volatilities"), py::arg("is_call"),
+        py::arg("rate"), py::arg("dividend_yields") = std::vector<double>(), py::arg("num_threads") = 0,
+        py::call_guard<py::gil_scoped_release>());
+    m_pricing.def("implied_volatility_batch", instrumented("pricing.implied_volatility_batch", &traider::pricing::implied_volatility_batch),
+        "Batch implied volatility (safeguarded Newton, NaN when outside no-arbitrage bounds)",
+        py::arg("prices"), py::arg("spots"), py::arg("strikes"), py::arg("times"), py::arg("is_call"),
+        py::arg("rate"), py::arg("dividend_yields") = std::vector<double>(), py::arg("tolerance") = 1e-8,
+        py::arg("max_iterations") = 100, py::arg("num_threads") = 0,
+        py::call_guard<py::gil_scoped_release>());
+    m_pricing.def("binomial_price", instrumented("pricing.binomial_price", &traider::pricing::binomial_price), "CRR binomial tree price",
+        py::arg("spot"), py::arg("strike"), py::arg("time_to_expiry"), py::arg("volatility"), py::arg("is_call"),
+        py::arg("rate"), py::arg("dividend_yield") = 0.0, py::arg("american") = true, py::arg("steps") = 200);
+    m_pricing.def("trinomial_price", instrumented("pricing.trinomial_price", &traider::pricing::trinomial_price), "Boyle trinomial tree price",
+        py::arg("spot"), py::arg("strike"), py::arg("time_to_expiry"), py::arg("volatility"), py::arg("is_call"),
+        py::arg("rate"), py::arg("dividend_yield") = 0.0, py::arg("american") = true, py::arg("steps") = 200);
+    m_pricing.def("american_price_batch", instrumented("pricing.american_price_batch", &traider::pricing::american_price_batch),
+        "Batch American-exercise prices on a binomial or trinomial tree",
+        py::arg("spots"), py::arg("strikes"), py::arg("times"), py::arg("volatilities"), py::arg("is_call"),
+        py::arg("rate"), py::arg("dividend_yields") = std::vector<double>(),
+        py::arg("model") = traider::pricing::LatticeModel::BINOMIAL, py::arg("steps") = 200,
+        py::arg("num_threads") = 0, py::call_guard<py::gil_scoped_release>());
+
+    // --- Accounts Module ---
+    auto m_accounts = m.def_submodule("accounts", "Multi-tenant simulator accounts and leaderboard");
+
+    py::enum_<traider::accounts::RankMetric>(m_accounts, "RankMetric")
+        .value("TOTAL_RETURN", traider::accounts::RankMetric::TOTAL_RETURN)
+        .value("SHARPE", traider::accounts::RankMetric::SHARPE)
+        .export_values();
+
+    py::enum_<traider::accounts::OrderStatus>(m_accounts, "OrderStatus")
+        .value("FILLED", traider::accounts::OrderStatus::FILLED)
+        .value("NO_PRICE", traider::accounts::OrderStatus::NO_PRICE)
+        .value("REJECTED", traider::accounts::OrderStatus::REJECTED)
+        .export_values();
+
+    py::class_<traider::accounts::OrderResult>(m_accounts, "OrderResult")
+        .def_readonly("order_id", &traider::accounts::OrderResult::order_id)
+        .def_readonly("ticker", &traider::accounts::OrderResult::ticker)
+        .def_readonly("status", &traider::accounts::OrderResult::status)
+        .def_readonly("quantity", &traider::accounts::OrderResult::quantity)
+        .def_readonly("price", &traider::accounts::OrderResult::price);
+
+    py::class_<traider::accounts::LeaderboardEntry>(m_accounts, "LeaderboardEntry")
+        .def_readonly("user_id", &traider::accounts::LeaderboardEntry::user_id)
+        .def_readonly("rank", &traider::accounts::LeaderboardEntry::rank)
+        .def_readonly("score", &traider::accounts::LeaderboardEntry::score)
+        .def_readonly("total_return", &traider::accounts::LeaderboardEntry::total_return)
+        .def_readonly("sharpe_ratio", &traider::accounts::LeaderboardEntry::sharpe_ratio)
+        .def_readonly("portfolio_value", &traider::accounts::LeaderboardEntry::portfolio_value);
+
+    py::class_<traider::accounts::AccountManager>(m_accounts, "AccountManager")
+        .def(py::init<size_t, traider::accounts::RankMetric, size_t>(),
+            py::arg("num_shards") = 0,
+            py::arg("metric") = traider::accounts::RankMetric::TOTAL_RETURN,
+            py::arg("queue_capacity") = 256)
+        .def("open_account", &traider::accounts::AccountManager::open_account,
+            py::arg("user_id"), py::arg("initial_capital"))
+        .def("has_account", &traider::accounts::AccountManager::has_account)
+        .def("submit_order", instrumented("accounts.AccountManager.submit_order", &traider::accounts::AccountManager::submit_order),
+            "Queue a market order and return its id (0 if refused); it fills at the last shared price",
+            py::arg("user_id"), py::arg("ticker"), py::arg("quantity"), py::arg("side"))
+        .def("update_price", instrumented("accounts.AccountManager.update_price", &traider::accounts::AccountManager::update_price),
+            py::arg("ticker"), py::arg("price"))
+        .def("process", instrumented("accounts.AccountManager.process", &traider::accounts::AccountManager::process),
+            py::call_guard<py::gil_scoped_release>())
+        .def("take_order_results", &traider::accounts::AccountManager::take_order_results,
+            "Drain the outcomes of the user's processed orders", py::arg("user_id"))
+        .def("leaderboard", &traider::accounts::AccountManager::leaderboard, py::arg("n") = 10)
+        .def("rank_of", &traider::accounts::AccountManager::rank_of)
+        .def("engine_snapshot", &traider::accounts::AccountManager::engine_snapshot,
+            "Copy of the account's trading engine, consistent with the last process()",
+            py::arg("user_id"))
+        .def("size", &traider::accounts::AccountManager::size)
+        .def("num_shards", &traider::accounts::AccountManager::num_shards);
+
+    // --- Replay Module ---
+    auto m_replay = m.def_submodule("replay", "Accelerated historical market replay");
+
+    py::enum_<traider::replay::ReplayDeltaType>(m_replay, "ReplayDeltaType")
+        .value("BAR", traider::replay::ReplayDeltaType::BAR)
+        .value("PORTFOLIO", traider::replay::ReplayDeltaType::PORTFOLIO)
+        .export_values();
+
+    py::class_<traider::replay::ReplayDelta>(m_replay, "ReplayDelta")
+        .def_readonly("type", &traider::replay::ReplayDelta::type)
+        .def_readonly("index", &traider::replay::ReplayDelta::index)
+        .def_readonly("timestamp", &traider::replay::ReplayDelta::timestamp)
+        .def_readonly("open", &traider::replay::ReplayDelta::open)
+        .def_readonly("high", &traider::replay::ReplayDelta::high)
+        .def_readonly("low", &traider::replay::ReplayDelta::low)
+        .def_readonly("close", &traider::replay::ReplayDelta::close)
+        .def_readonly("volume", &traider::replay::ReplayDelta::volume)
+        .def_readonly("sma", &traider::replay::ReplayDelta::sma)
+        .def_readonly("ema", &traider::replay::ReplayDelta::ema)
+        .def_readonly("rsi", &traider::replay::ReplayDelta::rsi)
+        .def_readonly("portfolio_value", &traider::replay::ReplayDelta::portfolio_value)
+        .def_readonly("capital", &traider::replay::ReplayDelta::capital);
+
+    py::class_<traider::replay::ReplayEngine>(m_replay, "ReplayEngine")
+        .def(py::init<size_t, int, int, int>(),
+            py::arg("buffer_capacity") = 4096, py::arg("sma_period") = 20,
+            py::arg("ema_period") = 20, py::arg("rsi_period") = 14)
+        .def("add_series", &traider::replay::ReplayEngine::add_series, py::arg("ticker"), py::arg("bars"))
+        .def("add_series_arrays",
+            [](traider::replay::ReplayEngine& self, const std::string& ticker,
+               const std::vector<long long>& timestamps, const std::vector<double>& opens,
+               const std::vector<double>& highs, const std::vector<double>& lows,
+               const std::vector<double>& closes, const std::vector<double>& volumes) {
+                size_t n = std::min({timestamps.size(), opens.size(), highs.size(),
+                                     lows.size(), closes.size(), volumes.size()});
+                std::vector<traider::data::OHLCV> bars(n);
+                for (size_t i = 0; i < n; ++i) {
+                    bars[i] = {opens[i], highs[i], lows[i], closes[i], volumes[i], timestamps[i]};
+                }
+                return self.add_series(ticker, bars);
+            },
+            "Add a series from parallel OHLCV arrays (timestamps in Unix seconds)",
+            py::arg("ticker"), py::arg("timestamps"), py::arg("opens"), py::arg("highs"),
+            py::arg("lows"), py::arg("closes"), py::arg("volumes"))
+        .def("subscribe", &traider::replay::ReplayEngine::subscribe, py::keep_alive<1, 2>())
+        .def("attach_accounts", &traider::replay::ReplayEngine::attach_accounts, py::keep_alive<1, 2>())
+        .def("set_speed", &traider::replay::ReplayEngine::set_speed)
+        .def("get_speed", &traider::replay::ReplayEngine::get_speed)
+        .def("start", &traider::replay::ReplayEngine::start)
+        .def("stop", &traider::replay::ReplayEngine::stop, py::call_guard<py::gil_scoped_release>())
+        .def("running", &traider::replay::ReplayEngine::running)
+        .def("finished", &traider::replay::ReplayEngine::finished)
+        .def("step", instrumented("replay.ReplayEngine.step", &traider::replay::ReplayEngine::step), py::arg("max_steps") = 1,
+            py::call_guard<py::gil_scoped_release>())
+        .def("poll", &traider::replay::ReplayEngine::poll, py::arg("max_deltas") = 1024)
+        .def("poll_json", instrumented("replay.ReplayEngine.poll_json", &traider::replay::ReplayEngine::poll_json), py::arg("max_deltas") = 1024)
+        .def("tickers", &traider::replay::ReplayEngine::tickers)
+        .def("current_time", &traider::replay::ReplayEngine::current_time)
+        .def("buffered", &traider::replay::ReplayEngine::buffered);
+
+    // --- Risk Module ---
+    auto m_risk = m.def_submodule("risk", "Incremental historical-simulation and parametric VaR");
+
+    py::class_<traider::risk::RiskResult>(m_risk, "RiskResult")
+        .def_readonly("var", &traider::risk::RiskResult::var)
+        .def_readonly("cvar", &traider::risk::RiskResult::cvar)
+        .def_readonly("parametric_var", &traider::risk::RiskResult::parametric_var)
+        .def_readonly("volatility", &traider::risk::RiskResult::volatility)
+        .def_readonly("exposure", &traider::risk::RiskResult::exposure)
+        .def_readonly("scenarios", &traider::risk::RiskResult::scenarios);
+
+    py::class_<traider::risk::RiskEngine>(m_risk, "RiskEngine")
+        .def(py::init<const std::vector<std::string>&, const std::vector<std::vector<double>>&, double>(),
+            py::arg("tickers"), py::arg("returns"), py::arg("confidence") = 0.99,
+            py::call_guard<py::gil_scoped_release>())
+        .def("num_assets", &traider::risk::RiskEngine::num_assets)
+        .def("num_scenarios", &traider::risk::RiskEngine::num_scenarios)
+        .def("num_portfolios", &traider::risk::RiskEngine::num_portfolios)
+        .def("confidence", &traider::risk::RiskEngine::confidence)
+        .def("add_portfolio", &traider::risk::RiskEngine::add_portfolio)
+        .def("has_portfolio", &traider::risk::RiskEngine::has_portfolio)
+        .def("set_position", instrumented("risk.RiskEngine.set_position", &traider::risk::RiskEngine::set_position),
+            py::arg("id"), py::arg("ticker"), py::arg("quantity"), py::arg("price") = 0.0)
+        .def("sync_positions", instrumented("risk.RiskEngine.sync_positions", &traider::risk::RiskEngine::sync_positions),
+            "Mirror a TradingEngine's positions; returns the count outside the universe",
+            py::arg("id"), py::arg("engine"))
+        .def("update_price", instrumented("risk.RiskEngine.update_price", &traider::risk::RiskEngine::update_price),
+            py::arg("ticker"), py::arg("price"), py::call_guard<py::gil_scoped_release>())
+        .def("get_price", &traider::risk::RiskEngine::get_price)
+        .def("refresh", instrumented("risk.RiskEngine.refresh", &traider::risk::RiskEngine::refresh),
+            "Recompute VaR/CVaR for portfolios changed since the last refresh",
+            py::arg("num_threads") = 0, py::call_guard<py::gil_scoped_release>())
+        .def("get_risk", &traider::risk::RiskEngine::get_risk)
+        .def("rebuild", &traider::risk::RiskEngine::rebuild);
+
+    // --- Metrics Module ---
+    auto m_metrics = m.def_submodule("metrics", "Hot-path instrumentation (call counts, bytes, latency percentiles)");
+
+    py::class_<traider::metrics::ProbeStats>(m_metrics, "ProbeStats")
+        .def_readonly("name", &traider::metrics::ProbeStats::name)
+        .def_readonly("calls", &traider::metrics::ProbeStats::calls)
+        .def_readonly("bytes", &traider::metrics::ProbeStats::bytes)
+        .def_readonly("total_ns", &traider::metrics::ProbeStats::total_ns)
+        .def_readonly("mean_ns", &traider::metrics::ProbeStats::mean_ns)
+        .def_readonly("p50_ns", &traider::metrics::ProbeStats::p50_ns)
+        .def_readonly("p99_ns", &traider::metrics::ProbeStats::p99_ns)
+        .def_readonly("p999_ns", &traider::metrics::ProbeStats::p999_ns)
+        .def_readonly("max_ns", &traider::metrics::ProbeStats::max_ns);
+
+    m_metrics.def("enable", []() { traider::metrics::set_enabled(true); }, "Start recording");
+    m_metrics.def("disable", []() { traider::metrics::set_enabled(false); }, "Stop recording");
+    m_metrics.def("is_enabled", &traider::metrics::is_enabled, "Whether recording is on");
+    m_metrics.def("snapshot", &traider::metrics::snapshot, "Per-probe stats since the last reset");
+    m_metrics.def("reset", &traider::metrics::reset, "Zero all probes");
+    m_metrics.def("record",
+        [](const std::string& name, uint64_t duration_ns, uint64_t bytes) {
+            if (!traider::metrics::is_enabled()) return;
+            traider::metrics::record(traider::metrics::register_probe(name), duration_ns, bytes);
+        },
+        "Record a Python-side timing (e.g. data fetch) under a named probe",
+        py::arg("name"), py::arg("duration_ns"), py::arg("bytes") = 0);
 
 }
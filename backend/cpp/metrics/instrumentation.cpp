@@ -0,0 +1,259 @@
+#include "instrumentation.h"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <unordered_map>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace traider {
+namespace metrics {
+
+    namespace {
+
+        // Counters owned by one thread. Only the owner writes (plain load+store,
+        // no locked RMW), readers take relaxed loads during snapshot().
+        struct Counters {
+            std::atomic<uint64_t> calls{0};
+            std::atomic<uint64_t> bytes{0};
+            std::atomic<uint64_t> total_ns{0};
+            std::atomic<uint64_t> buckets[kBucketCount];
+
+            Counters() {
+                for (auto& b : buckets) b.store(0, std::memory_order_relaxed);
+            }
+        };
+
+        struct ThreadSlot {
+            std::atomic<Counters*> probes[kMaxProbes];
+
+            ThreadSlot() {
+                for (auto& p : probes) p.store(nullptr, std::memory_order_relaxed);
+            }
+            ~ThreadSlot() {
+                for (auto& p : probes) delete p.load(std::memory_order_relaxed);
+            }
+        };
+
+        // Plain (non-atomic) totals used for merging, retired threads and reset baselines.
+        struct Totals {
+            uint64_t calls = 0;
+            uint64_t bytes = 0;
+            uint64_t total_ns = 0;
+            std::vector<uint64_t> buckets;
+
+            void add(const Counters& c) {
+                if (buckets.empty()) buckets.assign(kBucketCount, 0);
+                calls += c.calls.load(std::memory_order_relaxed);
+                bytes += c.bytes.load(std::memory_order_relaxed);
+                total_ns += c.total_ns.load(std::memory_order_relaxed);
+                for (int i = 0; i < kBucketCount; ++i) {
+                    buckets[i] += c.buckets[i].load(std::memory_order_relaxed);
+                }
+            }
+
+            void add(const Totals& t) {
+                if (t.buckets.empty()) return;
+                if (buckets.empty()) buckets.assign(kBucketCount, 0);
+                calls += t.calls;
+                bytes += t.bytes;
+                total_ns += t.total_ns;
+                for (int i = 0; i < kBucketCount; ++i) buckets[i] += t.buckets[i];
+            }
+        };
+
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::string> names;
+            std::unordered_map<std::string, int> ids;
+            std::vector<ThreadSlot*> live;
+            std::vector<Totals> retired = std::vector<Totals>(kMaxProbes);
+            std::vector<Totals> baseline = std::vector<Totals>(kMaxProbes);
+
+            // Raw (since process start) totals for every probe. Caller holds mutex.
+            std::vector<Totals> raw_totals() {
+                std::vector<Totals> totals(names.size());
+                for (size_t p = 0; p < names.size(); ++p) {
+                    totals[p].add(retired[p]);
+                    for (ThreadSlot* slot : live) {
+                        if (Counters* c = slot->probes[p].load(std::memory_order_acquire)) {
+                            totals[p].add(*c);
+                        }
+                    }
+                }
+                return totals;
+            }
+        };
+
+        // Intentionally leaked: thread-exit hooks may run during interpreter shutdown.
+        Registry& registry() {
+            static Registry* r = new Registry();
+            return *r;
+        }
+
+        // Folds the thread's counters into the retired totals when the thread exits,
+        // so short-lived worker threads do not lose their observations.
+        struct ThreadHandle {
+            ThreadSlot* slot = nullptr;
+
+            ~ThreadHandle() {
+                if (!slot) return;
+                Registry& r = registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                for (int p = 0; p < kMaxProbes; ++p) {
+                    if (Counters* c = slot->probes[p].load(std::memory_order_relaxed)) {
+                        r.retired[p].add(*c);
+                    }
+                }
+                r.live.erase(std::remove(r.live.begin(), r.live.end(), slot), r.live.end());
+                delete slot;
+            }
+        };
+
+        ThreadSlot& local_slot() {
+            thread_local ThreadHandle handle;
+            if (!handle.slot) {
+                handle.slot = new ThreadSlot();
+                Registry& r = registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                r.live.push_back(handle.slot);
+            }
+            return *handle.slot;
+        }
+
+        inline void bump(std::atomic<uint64_t>& counter, uint64_t value) {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        inline int highest_bit(uint64_t v) {
+#if defined(_MSC_VER)
+            unsigned long idx;
+            _BitScanReverse64(&idx, v);
+            return static_cast<int>(idx);
+#else
+            return 63 - __builtin_clzll(v);
+#endif
+        }
+
+        inline int bucket_index(uint64_t v) {
+            if (v < static_cast<uint64_t>(kSubBucketCount)) return static_cast<int>(v);
+            int shift = highest_bit(v) - kSubBucketBits;
+            return (shift + 1) * kSubBucketCount + static_cast<int>((v >> shift) & (kSubBucketCount - 1));
+        }
+
+        // [low, high) range of values that land in a bucket
+        inline void bucket_bounds(int idx, double& low, double& high) {
+            if (idx < kSubBucketCount) {
+                low = idx;
+                high = idx + 1.0;
+                return;
+            }
+            int shift = idx / kSubBucketCount - 1;
+            int sub = idx % kSubBucketCount;
+            low = std::ldexp(static_cast<double>(kSubBucketCount + sub), shift);
+            high = low + std::ldexp(1.0, shift);
+        }
+
+        double percentile(const std::vector<uint64_t>& buckets, uint64_t calls, double q) {
+            uint64_t rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(calls)));
+            if (rank == 0) rank = 1;
+            uint64_t seen = 0;
+            for (int i = 0; i < kBucketCount; ++i) {
+                seen += buckets[i];
+                if (seen >= rank) {
+                    double low, high;
+                    bucket_bounds(i, low, high);
+                    return (low + high) / 2.0;
+                }
+            }
+            return 0.0;
+        }
+
+    } // namespace
+
+    void set_enabled(bool enabled) {
+        detail::enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    int register_probe(const std::string& name) {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        auto it = r.ids.find(name);
+        if (it != r.ids.end()) return it->second;
+        if (static_cast<int>(r.names.size()) >= kMaxProbes) return -1;
+
+        int id = static_cast<int>(r.names.size());
+        r.names.push_back(name);
+        r.ids.emplace(name, id);
+        return id;
+    }
+
+    void record(int probe, uint64_t duration_ns, uint64_t bytes) {
+        if (probe < 0 || probe >= kMaxProbes) return;
+
+        ThreadSlot& slot = local_slot();
+        Counters* c = slot.probes[probe].load(std::memory_order_relaxed);
+        if (!c) {
+            c = new Counters();
+            slot.probes[probe].store(c, std::memory_order_release);
+        }
+
+        bump(c->calls, 1);
+        bump(c->bytes, bytes);
+        bump(c->total_ns, duration_ns);
+        bump(c->buckets[bucket_index(duration_ns)], 1);
+    }
+
+    std::vector<ProbeStats> snapshot() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        auto totals = r.raw_totals();
+
+        std::vector<ProbeStats> result;
+        for (size_t p = 0; p < totals.size(); ++p) {
+            Totals& t = totals[p];
+            const Totals& base = r.baseline[p];
+            if (t.buckets.empty()) continue;
+
+            // Report relative to the last reset()
+            if (!base.buckets.empty()) {
+                t.calls -= base.calls;
+                t.bytes -= base.bytes;
+                t.total_ns -= base.total_ns;
+                for (int i = 0; i < kBucketCount; ++i) t.buckets[i] -= base.buckets[i];
+            }
+            if (t.calls == 0) continue;
+
+            ProbeStats stats;
+            stats.name = r.names[p];
+            stats.calls = t.calls;
+            stats.bytes = t.bytes;
+            stats.total_ns = t.total_ns;
+            stats.mean_ns = static_cast<double>(t.total_ns) / t.calls;
+            stats.p50_ns = percentile(t.buckets, t.calls, 0.50);
+            stats.p99_ns = percentile(t.buckets, t.calls, 0.99);
+            stats.p999_ns = percentile(t.buckets, t.calls, 0.999);
+            stats.max_ns = 0.0;
+            for (int i = kBucketCount - 1; i >= 0; --i) {
+                if (t.buckets[i] > 0) {
+                    double low;
+                    bucket_bounds(i, low, stats.max_ns);
+                    break;
+                }
+            }
+            result.push_back(stats);
+        }
+        return result;
+    }
+
+    void reset() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        auto totals = r.raw_totals();
+        for (size_t p = 0; p < totals.size(); ++p) r.baseline[p] = std::move(totals[p]);
+    }
+
+} // namespace metrics
+} // namespace traider
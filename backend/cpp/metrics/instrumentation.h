@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace traider {
+namespace metrics {
+
+    // Log-linear (HDR-style) histogram layout: values below 16ns get their own
+    // bucket, above that every power of two is split into 16 sub-buckets,
+    // bounding the relative error of a reported percentile to ~6%.
+    constexpr int kSubBucketBits = 4;
+    constexpr int kSubBucketCount = 1 << kSubBucketBits;
+    constexpr int kBucketCount = kSubBucketCount * (64 - kSubBucketBits + 1);
+    constexpr int kMaxProbes = 256;
+
+    struct ProbeStats {
+        std::string name;
+        uint64_t calls;
+        uint64_t bytes;       // Input payload bytes handed to the probe
+        uint64_t total_ns;
+        double mean_ns;
+        double p50_ns;
+        double p99_ns;
+        double p999_ns;
+        double max_ns;        // Upper edge of the highest non-empty bucket
+    };
+
+    namespace detail {
+        inline std::atomic<bool> enabled{false};
+    }
+
+    /**
+     * @brief Global runtime switch. When off, a ScopedTimer costs one relaxed load.
+     */
+    inline bool is_enabled() { return detail::enabled.load(std::memory_order_relaxed); }
+    void set_enabled(bool enabled);
+
+    /**
+     * @brief Get (or create) the id of a named probe. Idempotent and thread-safe;
+     * call once and cache the id (e.g. in a function-local static).
+     * @return Probe id, or -1 if kMaxProbes is exhausted
+     */
+    int register_probe(const std::string& name);
+
+    /**
+     * @brief Record one observation for a probe on the calling thread.
+     */
+    void record(int probe, uint64_t duration_ns, uint64_t bytes = 0);
+
+    /**
+     * @brief Merge all per-thread counters into one entry per probe that has
+     * been hit since the last reset.
+     */
+    std::vector<ProbeStats> snapshot();
+
+    /**
+     * @brief Zero every probe. Counters keep running; the current totals become
+     * the new baseline that later snapshots are reported against.
+     */
+    void reset();
+
+    // Times the enclosing scope and records it against a probe on destruction.
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(int probe, uint64_t bytes = 0)
+            : probe_(probe), bytes_(bytes), active_(probe >= 0 && is_enabled()) {
+            if (active_) start_ = std::chrono::steady_clock::now();
+        }
+
+        ~ScopedTimer() {
+            if (!active_) return;
+            auto elapsed = std::chrono::steady_clock::now() - start_;
+            record(probe_,
+                   static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                   bytes_);
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        bool active() const { return active_; }
+        void add_bytes(uint64_t bytes) { bytes_ += bytes; }
+
+    private:
+        int probe_;
+        uint64_t bytes_;
+        bool active_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+} // namespace metrics
+} // namespace traider
@@ -19,39 +19,43 @@ namespace portfolio {
         metrics.total_return = utils::pct_change(equity_curve.back(), equity_curve.front());
         metrics.max_drawdown = calculate_max_drawdown(equity_curve);
 
-        // Daily Returns for Sharpe/Sortino
-        std::vector<double> returns;
-        returns.reserve(equity_curve.size() - 1);
-        for (size_t i = 1; i < equity_curve.size(); ++i) {
-            double ret = (equity_curve[i] - equity_curve[i-1]) / equity_curve[i-1];
-            returns.push_back(ret);
+        // Daily returns for Sharpe/Sortino are derived on the fly in two passes
+        // (mean, then deviations) rather than materialized into temporary vectors.
+        size_t n = equity_curve.size() - 1;
+        auto return_at = [&equity_curve](size_t i) {
+            return (equity_curve[i + 1] - equity_curve[i]) / equity_curve[i];
+        };
+
+        double sum = 0.0;
+        for (size_t i = 0; i < n; ++i) sum += return_at(i);
+        double avg_return = sum / n;
+
+        double daily_rf = risk_free_rate / 252.0;
+        double sum_sq_diff = 0.0;
+        double downside_sum = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            double r = return_at(i);
+            double diff = r - avg_return;
+            sum_sq_diff += diff * diff;
+            if (r < daily_rf) {
+                downside_sum += (r - daily_rf) * (r - daily_rf);
+            }
         }
 
         // Sharpe Ratio
         // Annualize roughly by sqrt(252) assuming daily data
         // For generalized tool, we might need frequency input. Assuming daily here.
-        double avg_return = utils::mean(returns);
-        double std_return = utils::std_dev(returns);
+        double std_return = n > 1 ? std::sqrt(sum_sq_diff / (n - 1)) : 0.0; // Sample std, as utils::std_dev
         
         if (std_return > 1e-9) {
             // Daily Sharpe
-            double daily_rf = risk_free_rate / 252.0; 
             double daily_sharpe = (avg_return - daily_rf) / std_return;
             metrics.sharpe_ratio = daily_sharpe * std::sqrt(252.0);
             metrics.volatility = std_return * std::sqrt(252.0);
         }
 
         // Sortino Ratio (downside deviation)
-        std::vector<double> downside_returns;
-        double daily_rf = risk_free_rate / 252.0;
-        for (double r : returns) {
-            if (r < daily_rf) {
-                downside_returns.push_back((r - daily_rf) * (r - daily_rf));
-            } else {
-                downside_returns.push_back(0.0);
-            }
-        }
-        double downside_std = std::sqrt(utils::mean(downside_returns)); // Semi-deviation
+        double downside_std = std::sqrt(downside_sum / n); // Semi-deviation
         
         if (downside_std > 1e-9) {
              double daily_sortino = (avg_return - daily_rf) / downside_std;
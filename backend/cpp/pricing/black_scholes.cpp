@@ -0,0 +1,376 @@
+#include "black_scholes.h"
+#include "../utils/parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace traider {
+namespace pricing {
+
+    namespace {
+
+        constexpr double kTwoPi = 6.28318530717958647693;
+        constexpr double kInvSqrt2Pi = 0.39894228040143267794;
+        constexpr double kSqrt2 = 1.41421356237309504880;
+        constexpr double kLn2Hi = 6.93147180369123816490e-01;
+        constexpr double kLn2Lo = 1.90821492927058770002e-10;
+        constexpr double kLog2e = 1.44269504088896338700;
+        constexpr double kShifter = 6755399441055744.0; // 1.5 * 2^52: adding it rounds to an integer
+        constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+        constexpr double kMinVol = 1e-6;
+        constexpr double kMaxVol = 5.0;
+        constexpr size_t kBlock = 64;       // Contracts iterated in lockstep by the IV solver
+        constexpr size_t kMinChunk = 1024;  // Contracts worth a thread of their own
+
+        // The per-contract math below is branch-free (selects instead of if/else, no
+        // libm calls) so the batch loops vectorize. Building with -fno-math-errno and
+        // -fno-trapping-math lets the compiler if-convert the sqrt and the divisions.
+
+        inline double as_double(uint64_t bits) { double d; std::memcpy(&d, &bits, sizeof d); return d; }
+        inline uint64_t as_bits(double d) { uint64_t bits; std::memcpy(&bits, &d, sizeof bits); return bits; }
+
+        // exp(x) = 2^k * e^r with |r| <= ln2/2 and a degree-12 Taylor polynomial for e^r.
+        // Inputs are clamped to the normal range.
+        inline double vexp(double x) {
+            x = std::min(std::max(x, -708.0), 709.0);
+            double kd = x * kLog2e + kShifter;
+            uint64_t k = as_bits(kd) - as_bits(kShifter);
+            kd -= kShifter;
+            double r = x - kd * kLn2Hi - kd * kLn2Lo;
+            double p = 1.0 / 479001600.0;
+            p = p * r + 1.0 / 39916800.0;
+            p = p * r + 1.0 / 3628800.0;
+            p = p * r + 1.0 / 362880.0;
+            p = p * r + 1.0 / 40320.0;
+            p = p * r + 1.0 / 5040.0;
+            p = p * r + 1.0 / 720.0;
+            p = p * r + 1.0 / 120.0;
+            p = p * r + 1.0 / 24.0;
+            p = p * r + 1.0 / 6.0;
+            p = p * r + 0.5;
+            p = p * r + 1.0;
+            p = p * r + 1.0;
+            return p * as_double((k + 1023) << 52);
+        }
+
+        // log(x) = e*ln2 + 2*atanh((m-1)/(m+1)) with the mantissa m in [sqrt(1/2), sqrt(2)).
+        // -inf for 0 and NaN for x < 0, like std::log; positive x must be normal.
+        inline double vlog(double x) {
+            uint64_t bits = as_bits(x);
+            double m = as_double((bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL);
+            // Biased exponent to double without an int64 conversion instruction
+            double e = as_double(((bits >> 52) & 0x7ff) | 0x4330000000000000ULL) - 4503599627370496.0 - 1023.0;
+            bool high = m > kSqrt2;
+            m = high ? 0.5 * m : m;
+            e = high ? e + 1.0 : e;
+            double s = (m - 1.0) / (m + 1.0);
+            double s2 = s * s;
+            double p = 1.0 / 21.0;
+            p = p * s2 + 1.0 / 19.0;
+            p = p * s2 + 1.0 / 17.0;
+            p = p * s2 + 1.0 / 15.0;
+            p = p * s2 + 1.0 / 13.0;
+            p = p * s2 + 1.0 / 11.0;
+            p = p * s2 + 1.0 / 9.0;
+            p = p * s2 + 1.0 / 7.0;
+            p = p * s2 + 1.0 / 5.0;
+            p = p * s2 + 1.0 / 3.0;
+            p = p * s2 + 1.0;
+            double result = e * kLn2Hi + (e * kLn2Lo + 2.0 * s * p);
+            result = x == 0 ? -std::numeric_limits<double>::infinity() : result;
+            return x >= 0 ? result : kNaN;
+        }
+
+        // Hart's rational approximation as given by West (2005), accurate to about 1e-15.
+        // `gauss` is exp(-x^2 / 2), shared with the density by callers that need both.
+        // The tail's continued fraction a + 1/(a + 2/(a + 3/(a + 4/(a + 0.65)))) is
+        // expanded into numerator/denominator recurrences so each lane divides once.
+        inline double norm_cdf(double x, double gauss) {
+            double a = std::fabs(x);
+            double num = 3.52624965998911e-02;
+            num = num * a + 0.700383064443688;
+            num = num * a + 6.37396220353165;
+            num = num * a + 33.912866078383;
+            num = num * a + 112.079291497871;
+            num = num * a + 221.213596169931;
+            num = num * a + 220.206867912376;
+            double den = 8.83883476483184e-02;
+            den = den * a + 1.75566716318264;
+            den = den * a + 16.064177579207;
+            den = den * a + 86.7807322029461;
+            den = den * a + 296.564248779674;
+            den = den * a + 637.333633378831;
+            den = den * a + 793.826512519948;
+            den = den * a + 440.413735824752;
+            double n4 = a + 0.65;
+            double n3 = a * n4 + 4.0;
+            double n2 = a * n3 + 3.0 * n4;
+            double n1 = a * n2 + 2.0 * n3;
+            double n0 = a * n1 + n2;
+            bool central = a < 7.07106781186547;
+            double c = gauss * (central ? num : n1) / (central ? den : n0 * 2.506628274631);
+            c = a > 37.0 ? 0.0 : c;
+            return x > 0 ? 1.0 - c : c;
+        }
+
+        bool same_size(size_t n, const std::vector<double>& a, const std::vector<double>& b,
+                       const std::vector<double>& c, const std::vector<int>& d,
+                       const std::vector<double>& dividends) {
+            return a.size() == n && b.size() == n && c.size() == n && d.size() == n &&
+                   (dividends.empty() || dividends.size() == n);
+        }
+
+        inline double call_sign(int is_call) { return is_call != 0 ? 1.0 : -1.0; }
+
+        // Price and vega of one contract, w = +1 for calls and -1 for puts (N(-x) = 1 - N(x)).
+        // Expired or zero-vol contracts are worth intrinsic value; their lanes run on safe
+        // inputs and are discarded by the final selects.
+        inline void price_and_vega(double s, double k, double t, double v, double w, double r, double q,
+                                   double& price, double& vega) {
+            bool live = t > 0 && v > 0;
+            double tt = live ? t : 1.0;
+            double vv = live ? v : 1.0;
+            double sqrt_t = std::sqrt(tt);
+            double vol_sqrt_t = vv * sqrt_t;
+            double d1 = (vlog(s / k) + (r - q + 0.5 * vv * vv) * tt) / vol_sqrt_t;
+            double d2 = d1 - vol_sqrt_t;
+            double tc = std::max(t, 0.0);
+            double disc_s = q != 0 ? s * vexp(-q * tc) : s;
+            double disc_k = k * vexp(-r * tc);
+            double gauss_d1 = vexp(-0.5 * d1 * d1);
+            double gauss_d2 = vexp(-0.5 * d2 * d2);
+            double model = w * (disc_s * norm_cdf(w * d1, gauss_d1) - disc_k * norm_cdf(w * d2, gauss_d2));
+            price = live ? model : std::max(w * (disc_s - disc_k), 0.0);
+            vega = live ? disc_s * kInvSqrt2Pi * gauss_d1 * sqrt_t : 0.0;
+        }
+
+        // Dividends are a template parameter so the no-dividend loops carry no per-element test
+        template <bool HasDividends>
+        void price_range(const double* spots, const double* strikes, const double* times,
+                         const double* vols, const int* is_call, double rate, const double* dividends,
+                         double* out, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                double vega;
+                price_and_vega(spots[i], strikes[i], times[i], vols[i], call_sign(is_call[i]), rate,
+                               HasDividends ? dividends[i] : 0.0, out[i], vega);
+            }
+        }
+
+        // Greeks are computed into block-local columns and copied out: six output vectors
+        // written in one loop would need more runtime alias checks than GCC will version for
+        template <bool HasDividends>
+        void greeks_range(const double* spots, const double* strikes, const double* times,
+                          const double* vols, const int* is_call, double rate, const double* dividends,
+                          GreeksResult& out, size_t begin, size_t end) {
+            double price[kBlock], delta[kBlock], gamma[kBlock], vega[kBlock], theta[kBlock], rho[kBlock];
+
+            for (size_t base = begin; base < end; base += kBlock) {
+                size_t m = std::min(kBlock, end - base);
+                for (size_t j = 0; j < m; ++j) {
+                    size_t i = base + j;
+                    double s = spots[i], k = strikes[i], t = times[i], v = vols[i];
+                    double q = HasDividends ? dividends[i] : 0.0;
+                    double w = call_sign(is_call[i]);
+
+                    bool live = t > 0 && v > 0;
+                    double tt = live ? t : 1.0;
+                    double vv = live ? v : 1.0;
+                    double sqrt_t = std::sqrt(tt);
+                    double vol_sqrt_t = vv * sqrt_t;
+                    double d1 = (vlog(s / k) + (rate - q + 0.5 * vv * vv) * tt) / vol_sqrt_t;
+                    double d2 = d1 - vol_sqrt_t;
+                    double tc = std::max(t, 0.0);
+                    double disc_q = HasDividends ? vexp(-q * tc) : 1.0;
+                    double disc_r = vexp(-rate * tc);
+                    double gauss_d1 = vexp(-0.5 * d1 * d1);
+                    double pdf_d1 = kInvSqrt2Pi * gauss_d1;
+                    double nd1 = norm_cdf(w * d1, gauss_d1);
+                    double nd2 = norm_cdf(w * d2, vexp(-0.5 * d2 * d2));
+
+                    // Expired or zero-vol lanes: intrinsic price, delta 0 or +-1, other Greeks 0
+                    double decay = -s * disc_q * pdf_d1 * vv / (2.0 * sqrt_t);
+                    bool itm = w * (s - k) > 0;
+                    price[j] = live ? w * (s * disc_q * nd1 - k * disc_r * nd2)
+                                    : std::max(w * (s * disc_q - k * disc_r), 0.0);
+                    delta[j] = live ? w * disc_q * nd1 : (itm ? w : 0.0);
+                    gamma[j] = live ? disc_q * pdf_d1 / (s * vol_sqrt_t) : 0.0;
+                    vega[j] = live ? s * disc_q * pdf_d1 * sqrt_t : 0.0;
+                    theta[j] = live ? decay - w * rate * k * disc_r * nd2 + w * q * s * disc_q * nd1 : 0.0;
+                    rho[j] = live ? w * k * t * disc_r * nd2 : 0.0;
+                }
+                std::copy(price, price + m, out.price.begin() + base);
+                std::copy(delta, delta + m, out.delta.begin() + base);
+                std::copy(gamma, gamma + m, out.gamma.begin() + base);
+                std::copy(vega, vega + m, out.vega.begin() + base);
+                std::copy(theta, theta + m, out.theta.begin() + base);
+                std::copy(rho, rho + m, out.rho.begin() + base);
+            }
+        }
+
+    } // namespace
+
+    double bsm_price(double spot, double strike, double time_to_expiry, double volatility,
+                     bool is_call, double rate, double dividend_yield) {
+        double price, vega;
+        price_and_vega(spot, strike, time_to_expiry, volatility, is_call ? 1.0 : -1.0, rate,
+                       dividend_yield, price, vega);
+        return price;
+    }
+
+    std::vector<double> bsm_price_batch(
+        const std::vector<double>& spots,
+        const std::vector<double>& strikes,
+        const std::vector<double>& times,
+        const std::vector<double>& volatilities,
+        const std::vector<int>& is_call,
+        double rate,
+        const std::vector<double>& dividend_yields,
+        size_t num_threads
+    ) {
+        size_t n = spots.size();
+        if (!same_size(n, strikes, times, volatilities, is_call, dividend_yields)) return {};
+
+        std::vector<double> result(n);
+        auto range = dividend_yields.empty() ? price_range<false> : price_range<true>;
+        utils::parallel_for(n, [&](size_t begin, size_t end) {
+            range(spots.data(), strikes.data(), times.data(), volatilities.data(), is_call.data(),
+                  rate, dividend_yields.data(), result.data(), begin, end);
+        }, num_threads, kMinChunk);
+        return result;
+    }
+
+    GreeksResult bsm_greeks_batch(
+        const std::vector<double>& spots,
+        const std::vector<double>& strikes,
+        const std::vector<double>& times,
+        const std::vector<double>& volatilities,
+        const std::vector<int>& is_call,
+        double rate,
+        const std::vector<double>& dividend_yields,
+        size_t num_threads
+    ) {
+        GreeksResult out;
+        size_t n = spots.size();
+        if (!same_size(n, strikes, times, volatilities, is_call, dividend_yields)) return out;
+
+        out.price.resize(n);
+        out.delta.resize(n);
+        out.gamma.resize(n);
+        out.vega.resize(n);
+        out.theta.resize(n);
+        out.rho.resize(n);
+
+        auto range = dividend_yields.empty() ? greeks_range<false> : greeks_range<true>;
+        utils::parallel_for(n, [&](size_t begin, size_t end) {
+            range(spots.data(), strikes.data(), times.data(), volatilities.data(), is_call.data(),
+                  rate, dividend_yields.data(), out, begin, end);
+        }, num_threads, kMinChunk);
+        return out;
+    }
+
+    std::vector<double> implied_volatility_batch(
+        const std::vector<double>& prices,
+        const std::vector<double>& spots,
+        const std::vector<double>& strikes,
+        const std::vector<double>& times,
+        const std::vector<int>& is_call,
+        double rate,
+        const std::vector<double>& dividend_yields,
+        double tolerance,
+        int max_iterations,
+        size_t num_threads
+    ) {
+        size_t n = prices.size();
+        if (!same_size(n, spots, strikes, times, is_call, dividend_yields)) return {};
+
+        std::vector<double> result(n, kNaN);
+
+        auto solve_block = [&](size_t begin, size_t end) {
+            size_t m = end - begin;
+            // Inputs are gathered into contiguous block arrays so the lockstep evaluation vectorizes
+            double s[kBlock], k[kBlock], t[kBlock], w[kBlock], q[kBlock];
+            double sigma[kBlock], lo[kBlock], hi[kBlock], model[kBlock], vega[kBlock];
+            bool active[kBlock];
+            size_t remaining = 0;
+
+            for (size_t j = 0; j < m; ++j) {
+                size_t i = begin + j;
+                double p = prices[i];
+                s[j] = spots[i];
+                k[j] = strikes[i];
+                t[j] = times[i];
+                w[j] = call_sign(is_call[i]);
+                q[j] = dividend_yields.empty() ? 0.0 : dividend_yields[i];
+                sigma[j] = 0.2; // Inactive lanes are still evaluated, keep their inputs finite
+                active[j] = false;
+                if (!(s[j] > 0 && k[j] > 0 && t[j] > 0 && p > 0)) {
+                    s[j] = k[j] = t[j] = 1.0;
+                    continue;
+                }
+
+                // No-arbitrage bounds: intrinsic forward value below, discounted spot/strike above
+                double disc_s = s[j] * std::exp(-q[j] * t[j]);
+                double disc_k = k[j] * std::exp(-rate * t[j]);
+                double lower = std::max(w[j] * (disc_s - disc_k), 0.0);
+                double upper = w[j] > 0 ? disc_s : disc_k;
+                if (p < lower - tolerance || p >= upper) continue;
+
+                // Brenner-Subrahmanyam ATM approximation as the starting point
+                sigma[j] = std::min(std::max(p / s[j] * std::sqrt(kTwoPi / t[j]), 0.05), 2.0);
+                lo[j] = kMinVol;
+                hi[j] = kMaxVol;
+                active[j] = true;
+                ++remaining;
+            }
+
+            for (int iter = 0; iter < max_iterations && remaining > 0; ++iter) {
+                // Evaluate every contract in the block together
+                for (size_t j = 0; j < m; ++j) {
+                    price_and_vega(s[j], k[j], t[j], sigma[j], w[j], rate, q[j], model[j], vega[j]);
+                }
+
+                for (size_t j = 0; j < m; ++j) {
+                    if (!active[j]) continue;
+                    double diff = model[j] - prices[begin + j];
+                    if (std::abs(diff) < tolerance) {
+                        // Matching the price only at a clamp of [kMinVol, kMaxVol] is not a solution
+                        bool at_edge = sigma[j] - kMinVol < 1e-9 || kMaxVol - sigma[j] < 1e-6;
+                        result[begin + j] = at_edge ? kNaN : sigma[j];
+                        active[j] = false;
+                        --remaining;
+                        continue;
+                    }
+
+                    // Price is increasing in vol, so the sign of diff tightens the bracket
+                    if (diff > 0) hi[j] = sigma[j]; else lo[j] = sigma[j];
+
+                    double next = vega[j] > 1e-12 ? sigma[j] - diff / vega[j] : kNaN;
+                    if (!(next > lo[j] && next < hi[j])) next = 0.5 * (lo[j] + hi[j]);
+
+                    if (hi[j] - lo[j] < tolerance * 1e-2) {
+                        // A bracket that collapsed onto one of its initial ends never enclosed
+                        // the root: the price needs a vol outside [kMinVol, kMaxVol]
+                        bool open = lo[j] == kMinVol || hi[j] == kMaxVol;
+                        result[begin + j] = open ? kNaN : next;
+                        active[j] = false;
+                        --remaining;
+                        continue;
+                    }
+                    sigma[j] = next;
+                }
+            }
+            // Contracts still active when max_iterations runs out keep NaN
+        };
+
+        utils::parallel_for((n + kBlock - 1) / kBlock, [&](size_t block_begin, size_t block_end) {
+            for (size_t b = block_begin; b < block_end; ++b) {
+                solve_block(b * kBlock, std::min(n, (b + 1) * kBlock));
+            }
+        }, num_threads, kMinChunk / kBlock);
+        return result;
+    }
+
+} // namespace pricing
+} // namespace traider
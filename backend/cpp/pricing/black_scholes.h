@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace traider {
+namespace pricing {
+
+    // Option chains are passed as parallel arrays (one element per contract) so a
+    // chain spanning many underlyings and expiries is priced in one call.
+    // `is_call` is 1 for calls and 0 for puts. `dividend_yields` may be empty (= 0).
+    // Times are in years, rates and volatilities are annualized decimals.
+
+    struct GreeksResult {
+        std::vector<double> price;
+        std::vector<double> delta;
+        std::vector<double> gamma;
+        std::vector<double> vega;  // Per 1.00 change in volatility
+        std::vector<double> theta; // Per year
+        std::vector<double> rho;   // Per 1.00 change in rate
+    };
+
+    /**
+     * @brief Black-Scholes-Merton price of a single European option
+     */
+    double bsm_price(double spot, double strike, double time_to_expiry, double volatility,
+                     bool is_call, double rate, double dividend_yield = 0.0);
+
+    /**
+     * @brief Batch Black-Scholes-Merton prices
+     * @param num_threads Worker threads (0 = hardware concurrency)
+     */
+    std::vector<double> bsm_price_batch(
+        const std::vector<double>& spots,
+        const std::vector<double>& strikes,
+        const std::vector<double>& times,
+        const std::vector<double>& volatilities,
+        const std::vector<int>& is_call,
+        double rate,
+        const std::vector<double>& dividend_yields = {},
+        size_t num_threads = 0);
+
+    /**
+     * @brief Batch Black-Scholes-Merton prices and Greeks
+     */
+    GreeksResult bsm_greeks_batch(
+        const std::vector<double>& spots,
+        const std::vector<double>& strikes,
+        const std::vector<double>& times,
+        const std::vector<double>& volatilities,
+        const std::vector<int>& is_call,
+        double rate,
+        const std::vector<double>& dividend_yields = {},
+        size_t num_threads = 0);
+
+    /**
+     * @brief Batch implied volatility from market prices
+     *
+     * Lockstep Newton-Raphson over blocks of contracts, safeguarded by a
+     * bisection bracket: any step that leaves the bracket or stalls on a tiny
+     * vega falls back to bisection. Prices outside the no-arbitrage bounds,
+     * prices that need a volatility outside [1e-6, 5], and contracts that do
+     * not converge within max_iterations yield NaN.
+     */
+    std::vector<double> implied_volatility_batch(
+        const std::vector<double>& prices,
+        const std::vector<double>& spots,
+        const std::vector<double>& strikes,
+        const std::vector<double>& times,
+        const std::vector<int>& is_call,
+        double rate,
+        const std::vector<double>& dividend_yields = {},
+        double tolerance = 1e-8,
+        int max_iterations = 100,
+        size_t num_threads = 0);
+
+} // namespace pricing
+} // namespace traider
@@ -0,0 +1,113 @@
+#include "lattice.h"
+#include "black_scholes.h"
+#include "../utils/parallel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace traider {
+namespace pricing {
+
+    namespace {
+        inline double payoff(double s, double k, bool is_call) {
+            return is_call ? std::max(s - k, 0.0) : std::max(k - s, 0.0);
+        }
+    }
+
+    double binomial_price(double spot, double strike, double time_to_expiry, double volatility,
+                          bool is_call, double rate, double dividend_yield, bool american, int steps) {
+        if (time_to_expiry <= 0 || volatility <= 0 || steps < 1) {
+            return bsm_price(spot, strike, time_to_expiry, volatility, is_call, rate, dividend_yield);
+        }
+
+        double dt = time_to_expiry / steps;
+        double u = std::exp(volatility * std::sqrt(dt));
+        double d = 1.0 / u;
+        double p = (std::exp((rate - dividend_yield) * dt) - d) / (u - d);
+        double disc = std::exp(-rate * dt);
+        double pu = disc * p;
+        double pd = disc * (1.0 - p);
+        double u2 = u * u;
+
+        // Terminal payoffs; node j at level i has spot S * d^i * u^(2j)
+        std::vector<double> values(steps + 1);
+        double s = spot * std::pow(d, steps);
+        for (int j = 0; j <= steps; ++j, s *= u2) {
+            values[j] = payoff(s, strike, is_call);
+        }
+
+        for (int i = steps - 1; i >= 0; --i) {
+            double node = spot * std::pow(d, i);
+            for (int j = 0; j <= i; ++j, node *= u2) {
+                double cont = pu * values[j + 1] + pd * values[j];
+                values[j] = american ? std::max(cont, payoff(node, strike, is_call)) : cont;
+            }
+        }
+        return values[0];
+    }
+
+    double trinomial_price(double spot, double strike, double time_to_expiry, double volatility,
+                           bool is_call, double rate, double dividend_yield, bool american, int steps) {
+        if (time_to_expiry <= 0 || volatility <= 0 || steps < 1) {
+            return bsm_price(spot, strike, time_to_expiry, volatility, is_call, rate, dividend_yield);
+        }
+
+        double dt = time_to_expiry / steps;
+        double dx = volatility * std::sqrt(3.0 * dt);
+        double nu = rate - dividend_yield - 0.5 * volatility * volatility;
+        double drift = std::sqrt(dt / (12.0 * volatility * volatility)) * nu;
+        double disc = std::exp(-rate * dt);
+        double pu = disc * (1.0 / 6.0 + drift);
+        double pm = disc * (2.0 / 3.0);
+        double pd = disc * (1.0 / 6.0 - drift);
+        double up = std::exp(dx);
+
+        // Level i has 2i+1 nodes; node j has spot S * e^((j - i) dx)
+        int width = 2 * steps + 1;
+        std::vector<double> values(width);
+        double s = spot * std::exp(-steps * dx);
+        for (int j = 0; j < width; ++j, s *= up) {
+            values[j] = payoff(s, strike, is_call);
+        }
+
+        for (int i = steps - 1; i >= 0; --i) {
+            double node = spot * std::exp(-i * dx);
+            for (int j = 0; j <= 2 * i; ++j, node *= up) {
+                double cont = pu * values[j + 2] + pm * values[j + 1] + pd * values[j];
+                values[j] = american ? std::max(cont, payoff(node, strike, is_call)) : cont;
+            }
+        }
+        return values[0];
+    }
+
+    std::vector<double> american_price_batch(
+        const std::vector<double>& spots,
+        const std::vector<double>& strikes,
+        const std::vector<double>& times,
+        const std::vector<double>& volatilities,
+        const std::vector<int>& is_call,
+        double rate,
+        const std::vector<double>& dividend_yields,
+        LatticeModel model,
+        int steps,
+        size_t num_threads
+    ) {
+        size_t n = spots.size();
+        if (strikes.size() != n || times.size() != n || volatilities.size() != n || is_call.size() != n ||
+            (!dividend_yields.empty() && dividend_yields.size() != n)) {
+            return {};
+        }
+
+        std::vector<double> result(n);
+        utils::parallel_for(n, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                double q = dividend_yields.empty() ? 0.0 : dividend_yields[i];
+                result[i] = model == LatticeModel::TRINOMIAL
+                    ? trinomial_price(spots[i], strikes[i], times[i], volatilities[i], is_call[i] != 0, rate, q, true, steps)
+                    : binomial_price(spots[i], strikes[i], times[i], volatilities[i], is_call[i] != 0, rate, q, true, steps);
+            }
+        }, num_threads, 8);
+        return result;
+    }
+
+} // namespace pricing
+} // namespace traider
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace traider {
+namespace pricing {
+
+    enum class LatticeModel {
+        BINOMIAL,  // Cox-Ross-Rubinstein
+        TRINOMIAL  // Boyle
+    };
+
+    /**
+     * @brief Cox-Ross-Rubinstein binomial tree price
+     * @param american Allow early exercise at every node
+     * @param steps Time steps in the tree (O(steps^2) work)
+     */
+    double binomial_price(double spot, double strike, double time_to_expiry, double volatility,
+                          bool is_call, double rate, double dividend_yield = 0.0,
+                          bool american = true, int steps = 200);
+
+    /**
+     * @brief Boyle trinomial tree price. Converges faster than the binomial tree
+     * for the same step count at roughly 2x the work per step.
+     */
+    double trinomial_price(double spot, double strike, double time_to_expiry, double volatility,
+                           bool is_call, double rate, double dividend_yield = 0.0,
+                           bool american = true, int steps = 200);
+
+    /**
+     * @brief Batch American-exercise prices, one tree per contract, thread-parallel
+     * over contracts. Array layout matches bsm_price_batch.
+     */
+    std::vector<double> american_price_batch(
+        const std::vector<double>& spots,
+        const std::vector<double>& strikes,
+        const std::vector<double>& times,
+        const std::vector<double>& volatilities,
+        const std::vector<int>& is_call,
+        double rate,
+        const std::vector<double>& dividend_yields = {},
+        LatticeModel model = LatticeModel::BINOMIAL,
+        int steps = 200,
+        size_t num_threads = 0);
+
+} // namespace pricing
+} // namespace traider
@@ -0,0 +1,237 @@
+#include "replay_engine.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace traider {
+namespace replay {
+
+    namespace {
+        constexpr long long kNoTimestamp = std::numeric_limits<long long>::max();
+
+        void append_number(std::string& out, double value) {
+            if (std::isnan(value) || std::isinf(value)) {
+                out += "null";
+                return;
+            }
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%.10g", value);
+            out += buf;
+        }
+    }
+
+    ReplayEngine::ReplayEngine(size_t buffer_capacity, int sma_period, int ema_period, int rsi_period)
+        : sma_period_(sma_period), ema_period_(ema_period), rsi_period_(rsi_period),
+          buffer_capacity_(buffer_capacity) {}
+
+    ReplayEngine::~ReplayEngine() {
+        stop();
+    }
+
+    size_t ReplayEngine::add_series(const std::string& ticker, const std::vector<data::OHLCV>& bars) {
+        tickers_.push_back(ticker);
+        series_.push_back(std::make_unique<Series>(bars, sma_period_, ema_period_, rsi_period_));
+        return tickers_.size() - 1;
+    }
+
+    size_t ReplayEngine::subscribe(core::TradingEngine* engine) {
+        engines_.push_back(engine);
+        return engines_.size() - 1;
+    }
+
+    void ReplayEngine::attach_accounts(accounts::AccountManager* manager) {
+        accounts_ = manager;
+    }
+
+    void ReplayEngine::set_speed(double speed) {
+        speed_.store(speed, std::memory_order_relaxed);
+    }
+
+    double ReplayEngine::get_speed() const {
+        return speed_.load(std::memory_order_relaxed);
+    }
+
+    void ReplayEngine::ensure_ring() {
+        if (ring_) return;
+        // One timestamp emits at most one delta per series plus one per subscriber;
+        // the ring must hold at least a couple of those groups.
+        size_t group = series_.size() + engines_.size();
+        ring_ = std::make_unique<utils::SpscRing<ReplayDelta>>(std::max(buffer_capacity_, group * 2));
+    }
+
+    bool ReplayEngine::has_room() const {
+        return ring_->capacity() - ring_->size() >= series_.size() + engines_.size();
+    }
+
+    long long ReplayEngine::next_timestamp() const {
+        long long next = kNoTimestamp;
+        for (const auto& s : series_) {
+            if (s->cursor < s->bars.size() && s->bars[s->cursor].timestamp < next) {
+                next = s->bars[s->cursor].timestamp;
+            }
+        }
+        return next;
+    }
+
+    bool ReplayEngine::advance() {
+        long long ts = next_timestamp();
+        if (ts == kNoTimestamp) {
+            finished_.store(true, std::memory_order_release);
+            return false;
+        }
+
+        for (size_t i = 0; i < series_.size(); ++i) {
+            Series& s = *series_[i];
+            if (s.cursor >= s.bars.size() || s.bars[s.cursor].timestamp != ts) continue;
+            const data::OHLCV& bar = s.bars[s.cursor++];
+
+            ReplayDelta delta{};
+            delta.type = ReplayDeltaType::BAR;
+            delta.index = static_cast<uint32_t>(i);
+            delta.timestamp = ts;
+            delta.open = bar.open;
+            delta.high = bar.high;
+            delta.low = bar.low;
+            delta.close = bar.close;
+            delta.volume = bar.volume;
+            delta.sma = s.sma.update(bar.close);
+            delta.ema = s.ema.update(bar.close);
+            delta.rsi = s.rsi.update(bar.close);
+            ring_->try_push(delta);
+
+            for (core::TradingEngine* engine : engines_) engine->update_price(tickers_[i], bar.close);
+            if (accounts_) accounts_->update_price(tickers_[i], bar.close);
+        }
+
+        if (accounts_) accounts_->process();
+
+        for (size_t e = 0; e < engines_.size(); ++e) {
+            ReplayDelta delta{};
+            delta.type = ReplayDeltaType::PORTFOLIO;
+            delta.index = static_cast<uint32_t>(e);
+            delta.timestamp = ts;
+            delta.portfolio_value = engines_[e]->get_portfolio_value();
+            delta.capital = engines_[e]->get_capital();
+            ring_->try_push(delta);
+        }
+
+        current_time_.store(ts, std::memory_order_relaxed);
+        if (next_timestamp() == kNoTimestamp) finished_.store(true, std::memory_order_release);
+        return true;
+    }
+
+    size_t ReplayEngine::step(size_t max_steps) {
+        if (running()) return 0;
+        ensure_ring();
+
+        size_t steps = 0;
+        while (steps < max_steps && has_room() && advance()) ++steps;
+        return steps;
+    }
+
+    void ReplayEngine::start() {
+        if (running_.exchange(true)) return;
+        if (worker_.joinable()) worker_.join(); // previous run already finished
+        ensure_ring();
+        stop_requested_.store(false);
+        worker_ = std::thread(&ReplayEngine::run, this);
+    }
+
+    void ReplayEngine::stop() {
+        stop_requested_.store(true);
+        if (worker_.joinable()) worker_.join();
+        running_.store(false);
+    }
+
+    bool ReplayEngine::running() const {
+        return running_.load(std::memory_order_acquire);
+    }
+
+    bool ReplayEngine::finished() const {
+        return finished_.load(std::memory_order_acquire);
+    }
+
+    void ReplayEngine::run() {
+        using Clock = std::chrono::steady_clock;
+        // Sleep in short slices so stop() is honoured promptly at slow speeds
+        const auto max_slice = std::chrono::milliseconds(50);
+
+        auto deadline = Clock::now();
+        long long prev_ts = kNoTimestamp;
+
+        while (!stop_requested_.load(std::memory_order_relaxed)) {
+            // Back-pressure: wait for the consumer to make room for a full timestamp group
+            if (!has_room()) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                continue;
+            }
+
+            long long ts = next_timestamp();
+            if (ts == kNoTimestamp) { // Out of data, including a replay with no bars loaded
+                finished_.store(true, std::memory_order_release);
+                break;
+            }
+
+            double speed = speed_.load(std::memory_order_relaxed);
+            if (speed > 0 && prev_ts != kNoTimestamp) {
+                deadline += std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(static_cast<double>(ts - prev_ts) / speed));
+                while (!stop_requested_.load(std::memory_order_relaxed)) {
+                    auto now = Clock::now();
+                    if (now >= deadline) break;
+                    std::this_thread::sleep_for(std::min<Clock::duration>(deadline - now, max_slice));
+                }
+                if (stop_requested_.load(std::memory_order_relaxed)) break;
+            } else {
+                deadline = Clock::now();
+            }
+
+            advance();
+            prev_ts = ts;
+        }
+
+        running_.store(false, std::memory_order_release);
+    }
+
+    std::vector<ReplayDelta> ReplayEngine::poll(size_t max_deltas) {
+        std::vector<ReplayDelta> out;
+        if (ring_) ring_->pop_batch(out, max_deltas);
+        return out;
+    }
+
+    std::string ReplayEngine::poll_json(size_t max_deltas) {
+        auto deltas = poll(max_deltas);
+
+        std::string out = "[";
+        out.reserve(deltas.size() * 160 + 2);
+        for (size_t i = 0; i < deltas.size(); ++i) {
+            const ReplayDelta& d = deltas[i];
+            if (i > 0) out += ',';
+            if (d.type == ReplayDeltaType::BAR) {
+                out += "{\"type\":\"bar\",\"ticker\":\"";
+                out += tickers_[d.index];
+                out += "\",\"timestamp\":" + std::to_string(d.timestamp);
+                out += ",\"open\":"; append_number(out, d.open);
+                out += ",\"high\":"; append_number(out, d.high);
+                out += ",\"low\":"; append_number(out, d.low);
+                out += ",\"close\":"; append_number(out, d.close);
+                out += ",\"volume\":"; append_number(out, d.volume);
+                out += ",\"sma\":"; append_number(out, d.sma);
+                out += ",\"ema\":"; append_number(out, d.ema);
+                out += ",\"rsi\":"; append_number(out, d.rsi);
+            } else {
+                out += "{\"type\":\"portfolio\",\"subscriber\":" + std::to_string(d.index);
+                out += ",\"timestamp\":" + std::to_string(d.timestamp);
+                out += ",\"portfolio_value\":"; append_number(out, d.portfolio_value);
+                out += ",\"capital\":"; append_number(out, d.capital);
+            }
+            out += '}';
+        }
+        out += ']';
+        return out;
+    }
+
+} // namespace replay
+} // namespace traider
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../core/trading_engine.h"
+#include "../data/data_processor.h"
+#include "../indicators/streaming_indicators.h"
+#include "../accounts/account_manager.h"
+#include "../utils/spsc_ring.h"
+
+namespace traider {
+namespace replay {
+
+    enum class ReplayDeltaType {
+        BAR,
+        PORTFOLIO
+    };
+
+    struct ReplayDelta {
+        ReplayDeltaType type;
+        uint32_t index;      // Ticker index (BAR) or subscriber index (PORTFOLIO)
+        long long timestamp;
+        // BAR
+        double open;
+        double high;
+        double low;
+        double close;
+        double volume;
+        double sma;
+        double ema;
+        double rsi;
+        // PORTFOLIO
+        double portfolio_value;
+        double capital;
+    };
+
+    /**
+     * @brief Replays historical bars for one or many tickers on a simulated clock.
+     *
+     * Bars from all series are merged by timestamp. For each timestamp the
+     * streaming indicators are advanced, subscribed TradingEngines (and an
+     * attached AccountManager) are repriced, and the resulting deltas are
+     * pushed into a bounded SPSC ring. When the ring is full the clock stalls
+     * until the consumer catches up, so a slow client applies back-pressure
+     * instead of growing memory.
+     *
+     * Setup (add_series/subscribe/attach_accounts) must happen before start().
+     * While running, subscribed engines belong to the replay thread.
+     */
+    class ReplayEngine {
+    public:
+        ReplayEngine(size_t buffer_capacity = 4096, int sma_period = 20, int ema_period = 20, int rsi_period = 14);
+        ~ReplayEngine();
+
+        ReplayEngine(const ReplayEngine&) = delete;
+        ReplayEngine& operator=(const ReplayEngine&) = delete;
+
+        // Bars must be sorted by timestamp. Returns the ticker index.
+        size_t add_series(const std::string& ticker, const std::vector<data::OHLCV>& bars);
+
+        // Returns the subscriber index used in PORTFOLIO deltas
+        size_t subscribe(core::TradingEngine* engine);
+        void attach_accounts(accounts::AccountManager* manager);
+
+        /**
+         * @brief Playback speed relative to bar timestamps (seconds).
+         * 1.0 = real time, 60.0 = one minute per second, <= 0 = as fast as possible.
+         */
+        void set_speed(double speed);
+        double get_speed() const;
+
+        // Run the clock on a background thread; stop() joins it
+        void start();
+        void stop();
+        bool running() const;
+        bool finished() const;
+
+        /**
+         * @brief Advance the clock synchronously by up to `max_steps` timestamps,
+         * ignoring speed. Only valid while not running.
+         * @return Number of timestamps replayed
+         */
+        size_t step(size_t max_steps = 1);
+
+        // Consumer side of the ring
+        std::vector<ReplayDelta> poll(size_t max_deltas = 1024);
+        // Same as poll(), pre-serialized as a JSON array (NaN -> null)
+        std::string poll_json(size_t max_deltas = 1024);
+
+        const std::vector<std::string>& tickers() const { return tickers_; }
+        long long current_time() const { return current_time_.load(std::memory_order_relaxed); }
+        size_t buffered() const { return ring_ ? ring_->size() : 0; }
+
+    private:
+        struct Series {
+            std::vector<data::OHLCV> bars;
+            size_t cursor = 0;
+            indicators::StreamingSMA sma;
+            indicators::StreamingEMA ema;
+            indicators::StreamingRSI rsi;
+
+            Series(std::vector<data::OHLCV> b, int sma_period, int ema_period, int rsi_period)
+                : bars(std::move(b)), sma(sma_period), ema(ema_period), rsi(rsi_period) {}
+        };
+
+        void ensure_ring();
+        bool has_room() const;
+        long long next_timestamp() const;
+        // Replay every bar at the next timestamp; false when all series are exhausted
+        bool advance();
+        void run();
+
+        int sma_period_;
+        int ema_period_;
+        int rsi_period_;
+        std::vector<std::string> tickers_;
+        std::vector<std::unique_ptr<Series>> series_;
+        std::vector<core::TradingEngine*> engines_;
+        accounts::AccountManager* accounts_ = nullptr;
+
+        size_t buffer_capacity_;
+        std::unique_ptr<utils::SpscRing<ReplayDelta>> ring_;
+        std::atomic<double> speed_{0.0};
+        std::atomic<bool> stop_requested_{false};
+        std::atomic<bool> running_{false};
+        std::atomic<bool> finished_{false};
+        std::atomic<long long> current_time_{0};
+        std::thread worker_;
+    };
+
+} // namespace replay
+} // namespace traider
@@ -0,0 +1,324 @@
+#include "risk_engine.h"
+#include "../utils/parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace traider {
+namespace risk {
+
+    namespace {
+
+        // Inverse standard normal CDF (Acklam's rational approximation, |rel err| < 1.2e-9)
+        double inverse_normal_cdf(double p) {
+            static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                                       1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+            static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                                       6.680131188771972e+01, -1.328068155288572e+01};
+            static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                                       -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+            static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                                       3.754408661907416e+00};
+            const double p_low = 0.02425;
+
+            if (p < p_low) {
+                double q = std::sqrt(-2.0 * std::log(p));
+                return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+                       ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+            }
+            if (p > 1.0 - p_low) {
+                double q = std::sqrt(-2.0 * std::log(1.0 - p));
+                return -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+                        ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+            }
+            double q = p - 0.5;
+            double r = q * q;
+            return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+                   (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+        }
+
+        inline void axpy(double alpha, const double* x, double* y, size_t n) {
+            for (size_t i = 0; i < n; ++i) y[i] += alpha * x[i];
+        }
+
+    } // namespace
+
+    RiskEngine::RiskEngine(
+        const std::vector<std::string>& tickers,
+        const std::vector<std::vector<double>>& returns,
+        double confidence
+    ) : tickers_(tickers),
+        num_scenarios_(returns.empty() ? 0 : returns.front().size()),
+        confidence_(confidence) {
+        if (tickers.size() != returns.size()) {
+            throw std::invalid_argument("RiskEngine: one returns column per ticker required");
+        }
+        if (!(confidence > 0.0 && confidence < 1.0)) {
+            throw std::invalid_argument("RiskEngine: confidence must be in (0, 1)");
+        }
+        for (const auto& column : returns) {
+            if (column.size() != num_scenarios_) {
+                throw std::invalid_argument("RiskEngine: returns columns differ in length");
+            }
+        }
+
+        size_t n_assets = tickers_.size();
+        size_t S = num_scenarios_;
+        z_score_ = inverse_normal_cdf(confidence_);
+
+        for (size_t j = 0; j < n_assets; ++j) asset_ids_.emplace(tickers_[j], j);
+        prices_.assign(n_assets, 0.0);
+        holders_.resize(n_assets);
+
+        returns_.resize(n_assets * S);
+        mean_returns_.assign(n_assets, 0.0);
+        for (size_t j = 0; j < n_assets; ++j) {
+            std::copy(returns[j].begin(), returns[j].end(), returns_.begin() + j * S);
+            double sum = 0.0;
+            for (double r : returns[j]) sum += r;
+            mean_returns_[j] = S > 0 ? sum / S : 0.0;
+        }
+
+        // Sample covariance. Rows are independent, so split them over threads
+        // and fill the upper triangle, then mirror it.
+        covariance_.assign(n_assets * n_assets, 0.0);
+        if (S > 1) {
+            std::vector<double> centered(returns_.size());
+            for (size_t j = 0; j < n_assets; ++j) {
+                for (size_t s = 0; s < S; ++s) centered[j * S + s] = returns_[j * S + s] - mean_returns_[j];
+            }
+            utils::parallel_for(n_assets, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    const double* xi = centered.data() + i * S;
+                    for (size_t j = i; j < n_assets; ++j) {
+                        const double* xj = centered.data() + j * S;
+                        double sum = 0.0;
+                        for (size_t s = 0; s < S; ++s) sum += xi[s] * xj[s];
+                        covariance_[i * n_assets + j] = sum / (S - 1);
+                    }
+                }
+            }, 0, 16);
+            for (size_t i = 0; i < n_assets; ++i) {
+                for (size_t j = i + 1; j < n_assets; ++j) covariance_[j * n_assets + i] = covariance_[i * n_assets + j];
+            }
+        }
+    }
+
+    size_t RiskEngine::num_portfolios() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return portfolios_.size();
+    }
+
+    bool RiskEngine::add_portfolio(const std::string& id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (portfolio_ids_.count(id)) return false;
+
+        Portfolio p;
+        p.id = id;
+        p.quantity.assign(tickers_.size(), 0.0);
+        p.exposure.assign(tickers_.size(), 0.0);
+        p.sigma_w.assign(tickers_.size(), 0.0);
+        p.pnl.assign(num_scenarios_, 0.0);
+        p.result.scenarios = num_scenarios_;
+
+        portfolio_ids_.emplace(id, portfolios_.size());
+        portfolios_.push_back(std::move(p));
+        return true;
+    }
+
+    bool RiskEngine::has_portfolio(const std::string& id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return portfolio_ids_.count(id) > 0;
+    }
+
+    RiskEngine::Portfolio& RiskEngine::lookup(const std::string& id) {
+        auto it = portfolio_ids_.find(id);
+        if (it == portfolio_ids_.end()) throw std::out_of_range("Unknown portfolio: " + id);
+        return portfolios_[it->second];
+    }
+
+    int RiskEngine::asset_index(const std::string& ticker) const {
+        auto it = asset_ids_.find(ticker);
+        return it == asset_ids_.end() ? -1 : static_cast<int>(it->second);
+    }
+
+    void RiskEngine::apply_exposure_delta(Portfolio& p, size_t asset, double delta) {
+        if (delta == 0.0) return;
+
+        size_t n_assets = tickers_.size();
+        const double* cov_col = covariance_.data() + asset * n_assets; // Symmetric, so column == row
+        p.variance += 2.0 * delta * p.sigma_w[asset] + delta * delta * cov_col[asset];
+        axpy(delta, cov_col, p.sigma_w.data(), n_assets);
+        axpy(delta, returns_.data() + asset * num_scenarios_, p.pnl.data(), num_scenarios_);
+        p.mean += delta * mean_returns_[asset];
+        p.exposure[asset] += delta;
+        p.net_exposure += delta;
+        p.dirty = true;
+
+        if (++p.updates_since_rebuild >= kRebuildInterval) revalue(p);
+    }
+
+    void RiskEngine::apply_quantity(Portfolio& p, size_t asset, double quantity) {
+        double previous = p.quantity[asset];
+        if (quantity == previous) return;
+
+        uint32_t index = static_cast<uint32_t>(portfolio_ids_.at(p.id));
+        auto& holders = holders_[asset];
+        if (previous == 0.0) {
+            holders.push_back(index);
+        } else if (quantity == 0.0) {
+            auto it = std::find(holders.begin(), holders.end(), index);
+            if (it != holders.end()) {
+                *it = holders.back();
+                holders.pop_back();
+            }
+        }
+
+        p.quantity[asset] = quantity;
+        // Exposure is set exactly rather than by difference to avoid residue on close
+        apply_exposure_delta(p, asset, quantity * prices_[asset] - p.exposure[asset]);
+    }
+
+    bool RiskEngine::set_position(const std::string& id, const std::string& ticker, double quantity,
+                                  double price) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Portfolio& p = lookup(id);
+        int asset = asset_index(ticker);
+        if (asset < 0) return false;
+        if (price > 0 && prices_[asset] <= 0) set_price(static_cast<size_t>(asset), price);
+        apply_quantity(p, static_cast<size_t>(asset), quantity);
+        return true;
+    }
+
+    size_t RiskEngine::sync_positions(const std::string& id, const core::TradingEngine& engine) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Portfolio& p = lookup(id);
+        std::vector<double> target(tickers_.size(), 0.0);
+        size_t unmapped = 0;
+
+        for (const auto& entry : engine.get_positions()) {
+            const core::Position& pos = entry.second;
+            int asset = asset_index(entry.first);
+            if (asset < 0) {
+                if (pos.quantity != 0.0) ++unmapped;
+                continue;
+            }
+            if (pos.current_price > 0 && prices_[asset] <= 0) set_price(static_cast<size_t>(asset), pos.current_price);
+            target[asset] = pos.quantity;
+        }
+
+        for (size_t j = 0; j < target.size(); ++j) apply_quantity(p, j, target[j]);
+        return unmapped;
+    }
+
+    void RiskEngine::update_price(const std::string& ticker, double price) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        int asset = asset_index(ticker);
+        if (asset < 0) return;
+        set_price(static_cast<size_t>(asset), price);
+    }
+
+    void RiskEngine::set_price(size_t j, double price) {
+        if (price <= 0) return;
+        double previous = prices_[j];
+        prices_[j] = price;
+        if (price == previous) return;
+
+        // Holders are distinct portfolios, so they can be updated concurrently
+        const auto& holders = holders_[j];
+        utils::parallel_for(holders.size(), [&](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k) {
+                Portfolio& p = portfolios_[holders[k]];
+                apply_exposure_delta(p, j, p.quantity[j] * price - p.exposure[j]);
+            }
+        }, 0, 256);
+    }
+
+    double RiskEngine::get_price(const std::string& ticker) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        int asset = asset_index(ticker);
+        return asset < 0 ? 0.0 : prices_[asset];
+    }
+
+    void RiskEngine::revalue(Portfolio& p) {
+        size_t n_assets = tickers_.size();
+        std::fill(p.pnl.begin(), p.pnl.end(), 0.0);
+        std::fill(p.sigma_w.begin(), p.sigma_w.end(), 0.0);
+        p.mean = 0.0;
+        p.net_exposure = 0.0;
+
+        for (size_t j = 0; j < n_assets; ++j) {
+            double w = p.exposure[j];
+            if (w == 0.0) continue;
+            axpy(w, returns_.data() + j * num_scenarios_, p.pnl.data(), num_scenarios_);
+            axpy(w, covariance_.data() + j * n_assets, p.sigma_w.data(), n_assets);
+            p.mean += w * mean_returns_[j];
+            p.net_exposure += w;
+        }
+
+        p.variance = 0.0;
+        for (size_t j = 0; j < n_assets; ++j) p.variance += p.exposure[j] * p.sigma_w[j];
+        p.updates_since_rebuild = 0;
+        p.dirty = true;
+    }
+
+    void RiskEngine::rebuild(const std::string& id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        revalue(lookup(id));
+    }
+
+    void RiskEngine::compute(Portfolio& p, std::vector<double>& scratch) const {
+        RiskResult& r = p.result;
+        size_t S = num_scenarios_;
+        r.scenarios = S;
+        r.exposure = p.net_exposure;
+        r.volatility = std::sqrt(std::max(p.variance, 0.0));
+        r.parametric_var = z_score_ * r.volatility - p.mean;
+        p.dirty = false;
+
+        if (S == 0) {
+            r.var = r.cvar = 0.0;
+            return;
+        }
+
+        // Tail of the m worst scenarios. nth_element partitions in O(S) instead of sorting.
+        size_t m = static_cast<size_t>(std::ceil((1.0 - confidence_) * S - 1e-9));
+        m = std::min(std::max<size_t>(m, 1), S);
+
+        scratch.resize(S);
+        for (size_t s = 0; s < S; ++s) scratch[s] = -p.pnl[s];
+        auto cut = scratch.begin() + (S - m);
+        std::nth_element(scratch.begin(), cut, scratch.end());
+
+        double tail = 0.0;
+        for (auto it = cut; it != scratch.end(); ++it) tail += *it;
+        r.var = *cut;
+        r.cvar = tail / m;
+    }
+
+    size_t RiskEngine::refresh(size_t num_threads) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<size_t> dirty;
+        for (size_t i = 0; i < portfolios_.size(); ++i) {
+            if (portfolios_[i].dirty) dirty.push_back(i);
+        }
+
+        utils::parallel_for(dirty.size(), [&](size_t begin, size_t end) {
+            std::vector<double> scratch(num_scenarios_);
+            for (size_t k = begin; k < end; ++k) compute(portfolios_[dirty[k]], scratch);
+        }, num_threads, 64);
+        return dirty.size();
+    }
+
+    RiskResult RiskEngine::get_risk(const std::string& id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Portfolio& p = lookup(id);
+        if (p.dirty) {
+            std::vector<double> scratch;
+            compute(p, scratch);
+        }
+        return p.result;
+    }
+
+} // namespace risk
+} // namespace traider
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../core/trading_engine.h"
+
+namespace traider {
+namespace risk {
+
+    // Losses are reported as positive numbers in cash units.
+    struct RiskResult {
+        double var;             // Historical-simulation VaR
+        double cvar;            // Mean loss beyond the VaR scenario (expected shortfall)
+        double parametric_var;  // z * sigma - mu from the scenario covariance
+        double volatility;      // sigma of one-period P&L
+        double exposure;        // Net market value of mapped positions
+        size_t scenarios;
+    };
+
+    /**
+     * @brief Position-level VaR/CVaR for many portfolios over one shared
+     * historical returns matrix (scenarios x assets, stored column-major).
+     *
+     * Each portfolio keeps its scenario P&L vector, Sigma*w and w'Sigma*w. A
+     * change of d in one asset's exposure (a position change or a price tick)
+     * costs O(scenarios + assets):
+     *   pnl    += d * R[:, j]
+     *   var_p  += 2 d (Sigma w)_j + d^2 Sigma_jj
+     *   Sigma w += d * Sigma[:, j]
+     * and only marks the portfolio dirty. refresh() then recomputes quantiles
+     * for dirty portfolios with nth_element (O(scenarios), no sort), in parallel.
+     * Accumulated updates are periodically replaced by a full revaluation so
+     * rounding drift stays bounded.
+     *
+     * Thread-safe: public calls serialize on one mutex, so the bindings can
+     * release the GIL around them (refresh still parallelizes internally).
+     */
+    class RiskEngine {
+    public:
+        /**
+         * @param tickers Asset universe, one per returns column
+         * @param returns Per-asset one-period simple returns, all the same length
+         * @param confidence VaR confidence level, e.g. 0.99
+         * @throws std::invalid_argument on mismatched shapes or confidence outside (0, 1)
+         */
+        RiskEngine(
+            const std::vector<std::string>& tickers,
+            const std::vector<std::vector<double>>& returns,
+            double confidence = 0.99
+        );
+
+        size_t num_assets() const { return tickers_.size(); }
+        size_t num_scenarios() const { return num_scenarios_; }
+        size_t num_portfolios() const;
+        double confidence() const { return confidence_; }
+
+        // Returns false if the portfolio already exists
+        bool add_portfolio(const std::string& id);
+        bool has_portfolio(const std::string& id) const;
+
+        /**
+         * @brief Set one holding. Unknown tickers are ignored (returns false).
+         * Seeds the asset's price when none is known yet.
+         */
+        bool set_position(const std::string& id, const std::string& ticker, double quantity,
+                          double price = 0.0);
+
+        /**
+         * @brief Mirror a TradingEngine's positions (quantity and, for assets
+         * without a shared price yet, current_price). Holdings no longer in the
+         * engine are closed. Only changed assets are applied incrementally.
+         * @return Number of positions whose ticker is outside the universe
+         */
+        size_t sync_positions(const std::string& id, const core::TradingEngine& engine);
+
+        // Shared latest price; every holder is updated incrementally
+        void update_price(const std::string& ticker, double price);
+        double get_price(const std::string& ticker) const;
+
+        /**
+         * @brief Recompute VaR/CVaR for every portfolio touched since the last refresh.
+         * @param num_threads Worker threads (0 = hardware concurrency)
+         * @return Number of portfolios recomputed
+         */
+        size_t refresh(size_t num_threads = 0);
+
+        // Refreshes this portfolio first if it is dirty. Throws std::out_of_range for unknown ids.
+        RiskResult get_risk(const std::string& id);
+
+        // Revalue every scenario from scratch (also done automatically every kRebuildInterval updates)
+        void rebuild(const std::string& id);
+
+        static constexpr uint32_t kRebuildInterval = 4096;
+
+    private:
+        struct Portfolio {
+            std::string id;
+            std::vector<double> quantity;   // Per asset
+            std::vector<double> exposure;   // quantity * price, per asset
+            std::vector<double> pnl;        // Per scenario
+            std::vector<double> sigma_w;    // Sigma * exposure
+            double variance = 0.0;
+            double mean = 0.0;
+            double net_exposure = 0.0;
+            uint32_t updates_since_rebuild = 0;
+            bool dirty = true;
+            RiskResult result{0.0, 0.0, 0.0, 0.0, 0.0, 0};
+        };
+
+        // Callers hold mutex_
+        Portfolio& lookup(const std::string& id);
+        int asset_index(const std::string& ticker) const;
+        void set_price(size_t asset, double price);
+        void apply_quantity(Portfolio& p, size_t asset, double quantity);
+        void apply_exposure_delta(Portfolio& p, size_t asset, double delta);
+        void revalue(Portfolio& p);
+        void compute(Portfolio& p, std::vector<double>& scratch) const;
+
+        std::vector<std::string> tickers_;
+        std::unordered_map<std::string, size_t> asset_ids_;
+        size_t num_scenarios_;
+        double confidence_;
+        double z_score_;
+        std::vector<double> returns_;     // Column-major: asset j at [j * num_scenarios_, ...)
+        std::vector<double> mean_returns_;
+        std::vector<double> covariance_;  // num_assets x num_assets, symmetric
+        std::vector<double> prices_;
+
+        std::vector<Portfolio> portfolios_;
+        std::unordered_map<std::string, size_t> portfolio_ids_;
+        std::vector<std::vector<uint32_t>> holders_; // Per asset: portfolios with a nonzero quantity
+
+        mutable std::mutex mutex_; // Guards portfolios, prices and holders
+    };
+
+} // namespace risk
+} // namespace traider
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace traider {
+namespace utils {
+
+    /**
+     * @brief Bounded lock-free multi-producer queue (Vyukov sequence-number ring).
+     *
+     * Any number of threads may push concurrently; pops are also safe from
+     * several threads but the trading core only drains from one owner.
+     * Capacity is rounded up to a power of two.
+     */
+    template <typename T>
+    class BoundedMpscQueue {
+    public:
+        explicit BoundedMpscQueue(size_t capacity)
+            : mask_(round_up_pow2(capacity) - 1), cells_(mask_ + 1) {
+            for (size_t i = 0; i <= mask_; ++i) {
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        BoundedMpscQueue(const BoundedMpscQueue&) = delete;
+        BoundedMpscQueue& operator=(const BoundedMpscQueue&) = delete;
+
+        // Returns false if the queue is full
+        bool try_push(T value) {
+            size_t pos = tail_.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;) {
+                cell = &cells_[pos & mask_];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                if (diff == 0) {
+                    if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = tail_.load(std::memory_order_relaxed);
+                }
+            }
+            cell->value = std::move(value);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Returns false if the queue is empty
+        bool try_pop(T& out) {
+            size_t pos = head_.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;) {
+                cell = &cells_[pos & mask_];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+                if (diff == 0) {
+                    if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = head_.load(std::memory_order_relaxed);
+                }
+            }
+            out = std::move(cell->value);
+            cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool empty() const {
+            size_t pos = head_.load(std::memory_order_relaxed);
+            return cells_[pos & mask_].sequence.load(std::memory_order_acquire) != pos + 1;
+        }
+
+        size_t capacity() const { return mask_ + 1; }
+
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence{0};
+            T value{};
+        };
+
+        static size_t round_up_pow2(size_t v) {
+            size_t p = 2;
+            while (p < v) p <<= 1;
+            return p;
+        }
+
+        // Producers and the consumer touch different cache lines
+        alignas(64) std::atomic<size_t> tail_{0};
+        alignas(64) std::atomic<size_t> head_{0};
+        size_t mask_;
+        std::vector<Cell> cells_;
+    };
+
+} // namespace utils
+} // namespace traider
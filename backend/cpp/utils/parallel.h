@@ -0,0 +1,48 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace traider {
+namespace utils {
+
+    /**
+     * @brief Number of worker threads to use when the caller passes 0.
+     */
+    inline size_t default_thread_count() {
+        unsigned hw = std::thread::hardware_concurrency();
+        return hw == 0 ? 1 : static_cast<size_t>(hw);
+    }
+
+    /**
+     * @brief Split [0, n) into contiguous chunks and run fn(begin, end) on each,
+     * one chunk per thread. Runs inline when only one chunk is needed.
+     * @param max_threads Upper bound on threads (0 = hardware concurrency)
+     * @param min_chunk Smallest range worth handing to its own thread
+     */
+    template <typename Fn>
+    void parallel_for(size_t n, Fn&& fn, size_t max_threads = 0, size_t min_chunk = 1) {
+        if (n == 0) return;
+        if (max_threads == 0) max_threads = default_thread_count();
+        size_t chunks = std::min(max_threads, std::max<size_t>(1, n / std::max<size_t>(1, min_chunk)));
+
+        if (chunks <= 1) {
+            fn(size_t{0}, n);
+            return;
+        }
+
+        size_t step = (n + chunks - 1) / chunks;
+        std::vector<std::thread> workers;
+        workers.reserve(chunks - 1);
+        for (size_t begin = step; begin < n; begin += step) {
+            size_t end = std::min(n, begin + step);
+            workers.emplace_back([&fn, begin, end]() { fn(begin, end); });
+        }
+        fn(size_t{0}, std::min(n, step)); // first chunk on the calling thread
+        for (auto& w : workers) w.join();
+    }
+
+} // namespace utils
+} // namespace traider
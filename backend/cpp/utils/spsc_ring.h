@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace traider {
+namespace utils {
+
+    /**
+     * @brief Bounded single-producer/single-consumer ring buffer.
+     *
+     * Exactly one thread may push and one (other) thread may pop. Both sides
+     * cache the opposite index so the common case touches no shared line.
+     * Capacity is rounded up to a power of two.
+     */
+    template <typename T>
+    class SpscRing {
+    public:
+        explicit SpscRing(size_t capacity)
+            : mask_(round_up_pow2(capacity) - 1), slots_(mask_ + 1) {}
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        // Producer side. Returns false if full.
+        bool try_push(const T& value) {
+            size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - head_cache_ > mask_) {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                if (tail - head_cache_ > mask_) return false;
+            }
+            slots_[tail & mask_] = value;
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side. Pops up to `max` items into `out`, returns the count.
+        size_t pop_batch(std::vector<T>& out, size_t max) {
+            size_t head = head_.load(std::memory_order_relaxed);
+            if (tail_cache_ == head) {
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+                if (tail_cache_ == head) return 0;
+            }
+            size_t n = tail_cache_ - head;
+            if (n > max) n = max;
+            for (size_t i = 0; i < n; ++i) out.push_back(slots_[(head + i) & mask_]);
+            head_.store(head + n, std::memory_order_release);
+            return n;
+        }
+
+        // Approximate when called concurrently
+        size_t size() const {
+            return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+        }
+
+        size_t capacity() const { return mask_ + 1; }
+
+    private:
+        static size_t round_up_pow2(size_t v) {
+            size_t p = 2;
+            while (p < v) p <<= 1;
+            return p;
+        }
+
+        alignas(64) std::atomic<size_t> tail_{0};
+        size_t head_cache_ = 0; // producer's view of head_
+        alignas(64) std::atomic<size_t> head_{0};
+        size_t tail_cache_ = 0; // consumer's view of tail_
+        alignas(64) size_t mask_;
+        std::vector<T> slots_;
+    };
+
+} // namespace utils
+} // namespace traider
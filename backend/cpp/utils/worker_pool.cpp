@@ -0,0 +1,69 @@
+#include "worker_pool.h"
+#include "parallel.h"
+
+namespace traider {
+namespace utils {
+
+    WorkerPool::WorkerPool(size_t num_threads) {
+        if (num_threads == 0) num_threads = default_thread_count();
+        workers_.reserve(num_threads - 1);
+        for (size_t i = 1; i < num_threads; ++i) {
+            workers_.emplace_back([this]() { worker_loop(); });
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& w : workers_) w.join();
+    }
+
+    void WorkerPool::dispatch(size_t n, Task task, void* ctx) {
+        std::lock_guard<std::mutex> run_lock(run_mutex_);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = task;
+            ctx_ = ctx;
+            n_ = n;
+            next_.store(0, std::memory_order_relaxed);
+            active_ = workers_.size();
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        drain(); // The caller works too
+
+        // Every worker checks in before returning, so none still reads this run's task
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this]() { return active_ == 0; });
+    }
+
+    void WorkerPool::drain() {
+        for (size_t i = next_.fetch_add(1, std::memory_order_relaxed); i < n_;
+             i = next_.fetch_add(1, std::memory_order_relaxed)) {
+            task_(ctx_, i);
+        }
+    }
+
+    void WorkerPool::worker_loop() {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&]() { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+            }
+            drain();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--active_ == 0) done_.notify_one();
+            }
+        }
+    }
+
+} // namespace utils
+} // namespace traider
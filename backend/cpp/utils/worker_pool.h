@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace traider {
+namespace utils {
+
+    /**
+     * @brief Persistent worker threads for fork-join loops on hot paths.
+     *
+     * Unlike parallel_for, which starts and joins threads on every call, the
+     * workers are started once and park on a condition variable between runs,
+     * so a run costs a wake-up rather than thread creation and does no heap
+     * allocation. Runs on one pool are serialized; fn must not call run() on
+     * the pool it is running on.
+     */
+    class WorkerPool {
+    public:
+        // num_threads counts the calling thread (0 = hardware concurrency)
+        explicit WorkerPool(size_t num_threads = 0);
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        // Threads taking part in a run, the caller included
+        size_t size() const { return workers_.size() + 1; }
+
+        /**
+         * @brief Call fn(i) once for every i in [0, n), spread over the workers and
+         * the calling thread. Returns when all calls have finished. Runs inline
+         * when there is a single item or no worker threads.
+         */
+        template <typename Fn>
+        void run(size_t n, Fn&& fn) {
+            if (n == 0) return;
+            if (n == 1 || workers_.empty()) {
+                for (size_t i = 0; i < n; ++i) fn(i);
+                return;
+            }
+            using F = std::remove_reference_t<Fn>;
+            dispatch(n, [](void* ctx, size_t i) { (*static_cast<F*>(ctx))(i); },
+                     const_cast<void*>(static_cast<const void*>(std::addressof(fn))));
+        }
+
+    private:
+        using Task = void (*)(void*, size_t);
+
+        void dispatch(size_t n, Task task, void* ctx);
+        void drain();
+        void worker_loop();
+
+        std::vector<std::thread> workers_;
+
+        std::mutex run_mutex_; // Serializes run() callers
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable done_;
+        uint64_t generation_ = 0;
+        size_t active_ = 0;
+        bool stop_ = false;
+
+        // Current run; written under mutex_ before generation_ is bumped
+        Task task_ = nullptr;
+        void* ctx_ = nullptr;
+        size_t n_ = 0;
+        std::atomic<size_t> next_{0};
+    };
+
+} // namespace utils
+} // namespace traider
@@ -1,4 +1,4 @@
-from fastapi import FastAPI, HTTPException
+from fastapi import FastAPI, HTTPException, WebSocket, WebSocketDisconnect
 from yahoo_fin.stock_info import get_data
 from fastapi.middleware.cors import CORSMiddleware
 from datetime import datetime, timedelta
@@ -8,7 +8,14 @@ import os
 from dotenv import load_dotenv
 from pydantic import BaseModel
 from typing import List, Dict, Optional
+from contextlib import contextmanager
+from collections import OrderedDict
 import sys
+import time
+import json
+import asyncio
+import math
+import threading
 
 # Try to import the C++ extension
 try:
@@ -19,6 +26,23 @@ except ImportError as e:
     CPP_AVAILABLE = False
     print(f"Warning: C++ extension not available: {e}")
 
+# Metrics need a build that includes the instrumentation module
+METRICS_AVAILABLE = CPP_AVAILABLE and hasattr(traider_cpp, "metrics")
+if METRICS_AVAILABLE and os.getenv("TRAIDER_METRICS", "0") == "1":
+    traider_cpp.metrics.enable()
+
+@contextmanager
+def timed(stage: str, nbytes: int = 0):
+    """Record the wall time of a Python-side stage under `stage` in the C++ metrics registry."""
+    if not METRICS_AVAILABLE or not traider_cpp.metrics.is_enabled():
+        yield
+        return
+    start = time.perf_counter_ns()
+    try:
+        yield
+    finally:
+        traider_cpp.metrics.record(stage, time.perf_counter_ns() - start, nbytes)
+
 # Load environment variables from .env.local
 load_dotenv(dotenv_path=os.path.join(os.path.dirname(__file__), "../.env.local"))
 
@@ -181,30 +205,33 @@ def get_technical_indicators(request: TechnicalIndicatorsRequest):
         end_date = datetime.now()
         start_date = end_date - timedelta(days=730)
         
-        stock_data = get_data(
-            request.ticker,
-            start_date=start_date,
-            end_date=end_date,
-            index_as_date=False
-        )
+        with timed("server.technical_indicators.fetch"):
+            stock_data = get_data(
+                request.ticker,
+                start_date=start_date,
+                end_date=end_date,
+                index_as_date=False
+            )
         
         if stock_data is None or stock_data.empty:
             raise HTTPException(status_code=404, detail="Stock data not found")
 
         # Prepare data for C++
-        prices = stock_data['close'].tolist()
-        volumes = stock_data['volume'].tolist()
-        dates = stock_data['date'].astype(str).tolist()
+        with timed("server.technical_indicators.to_list", len(stock_data) * 16):
+            prices = stock_data['close'].tolist()
+            volumes = stock_data['volume'].tolist()
+            dates = stock_data['date'].astype(str).tolist()
 
         # Calculate indicators using C++
         # We'll calculate a standard suite
-        sma_val = traider_cpp.indicators.sma(prices, request.period)
-        ema_val = traider_cpp.indicators.ema(prices, request.period)
-        rsi_val = traider_cpp.indicators.rsi(prices, 14)
-        vwap_val = traider_cpp.indicators.vwap(prices, volumes)
-        
-        # Bollinger Bands (default 20, 2.0)
-        bb = traider_cpp.indicators.bollinger_bands(prices, 20, 2.0)
+        with timed("server.technical_indicators.kernels", len(prices) * 8):
+            sma_val = traider_cpp.indicators.sma(prices, request.period)
+            ema_val = traider_cpp.indicators.ema(prices, request.period)
+            rsi_val = traider_cpp.indicators.rsi(prices, 14)
+            vwap_val = traider_cpp.indicators.vwap(prices, volumes)
+            
+            # Bollinger Bands (default 20, 2.0)
+            bb = traider_cpp.indicators.bollinger_bands(prices, 20, 2.0)
         
         # Combine results
         # We return the last N points to keep payload size reasonable, or all if requested
@@ -271,6 +298,7 @@ class TradeAnalysisRequest(BaseModel):
     buy_date: str
     sell_date: str
     initial_investment: float
+    whole_shares: bool = False  # Integer fixed-point mode: whole-share fills, exact P&L
 
 @app.post("/analyze-trade")
 def analyze_trade(request: TradeAnalysisRequest):
@@ -288,12 +316,13 @@ def analyze_trade(request: TradeAnalysisRequest):
         
         # Add buffer for indicators if needed, but for simple trade analysis, exact range is key
         # We need daily data
-        stock_data = get_data(
-            request.ticker,
-            start_date=start_date,
-            end_date=end_date + timedelta(days=1), # Include sell date
-            index_as_date=False
-        )
+        with timed("server.analyze_trade.fetch"):
+            stock_data = get_data(
+                request.ticker,
+                start_date=start_date,
+                end_date=end_date + timedelta(days=1), # Include sell date
+                index_as_date=False
+            )
 
         if stock_data is None or stock_data.empty:
             raise HTTPException(status_code=404, detail="Stock data not found for the given period")
@@ -313,7 +342,13 @@ def analyze_trade(request: TradeAnalysisRequest):
             signals[-1] = -1 # Sell all
         
         bt_engine = traider_cpp.backtesting.BacktestEngine(request.initial_investment)
-        result = bt_engine.run_simple(request.ticker, prices, signals)
+        if request.whole_shares and hasattr(bt_engine, "run_simple_fixed"):
+            try:
+                result = bt_engine.run_simple_fixed(request.ticker, prices, signals)
+            except (ValueError, IndexError) as e:  # Amount or price outside the int64 fixed-point range
+                raise HTTPException(status_code=400, detail=str(e))
+        else:
+            result = bt_engine.run_simple(request.ticker, prices, signals)
 
         # 3. Construct Response
         metrics = result.metrics
@@ -340,6 +375,459 @@ def analyze_trade(request: TradeAnalysisRequest):
             ]
         }
 
+    except HTTPException:
+        raise
     except Exception as e:
         print(f"Error analyzing trade: {e}")
         raise HTTPException(status_code=500, detail=str(e))
+
+# --- Options ---
+
+# Request sizes are bounded: closed-form pricing and IV are O(n), lattice pricing
+# is O(n * steps^2), so the lattice is capped on total node updates as well
+MAX_CHAIN_CONTRACTS = 100_000
+MAX_LATTICE_STEPS = 2000
+MAX_LATTICE_NODES = 200_000_000  # ~0.3 s at the binomial kernel's ~1.5 ns per node
+
+def _finite_positive(values):
+    return all(math.isfinite(v) and v > 0 for v in values)
+
+def _nan_to_none(values):
+    # NaN is not valid JSON (JSONResponse uses allow_nan=False)
+    return [None if v != v else v for v in values]
+
+class OptionChainRequest(BaseModel):
+    spots: List[float]
+    strikes: List[float]
+    times: List[float]  # Years to expiry
+    volatilities: List[float]
+    is_call: List[bool]
+    rate: float = 0.02
+    dividend_yields: List[float] = []
+    american: bool = False
+    steps: int = 200
+    market_prices: Optional[List[float]] = None  # If given, implied vols are solved too
+
+@app.post("/options/chain")
+def price_option_chain(request: OptionChainRequest):
+    """
+    Price a whole option chain (any mix of underlyings and expiries) with Greeks using the C++ pricing module.
+    """
+    if not CPP_AVAILABLE or not hasattr(traider_cpp, "pricing"):
+        raise HTTPException(status_code=501, detail="C++ pricing module not available")
+
+    n = len(request.spots)
+    if any(len(v) != n for v in (request.strikes, request.times, request.volatilities, request.is_call)):
+        raise HTTPException(status_code=400, detail="All per-contract arrays must have the same length")
+    if request.dividend_yields and len(request.dividend_yields) != n:
+        raise HTTPException(status_code=400, detail="dividend_yields must be empty or match the chain length")
+    if n > MAX_CHAIN_CONTRACTS:
+        raise HTTPException(status_code=400, detail=f"At most {MAX_CHAIN_CONTRACTS} contracts per chain")
+    if request.american:
+        if not 1 <= request.steps <= MAX_LATTICE_STEPS:
+            raise HTTPException(status_code=400, detail=f"steps must be between 1 and {MAX_LATTICE_STEPS}")
+        if n * request.steps * request.steps > MAX_LATTICE_NODES:
+            raise HTTPException(status_code=400, detail="Chain too large for lattice pricing; reduce contracts or steps")
+    for name in ("spots", "strikes", "times", "volatilities"):
+        if not _finite_positive(getattr(request, name)):
+            raise HTTPException(status_code=400, detail=f"{name} must be finite and > 0")
+    if not math.isfinite(request.rate) or not all(math.isfinite(q) for q in request.dividend_yields):
+        raise HTTPException(status_code=400, detail="rate and dividend_yields must be finite")
+    if request.market_prices is not None:
+        if len(request.market_prices) != n:
+            raise HTTPException(status_code=400, detail="market_prices must match the chain length")
+        if not all(math.isfinite(p) for p in request.market_prices):
+            raise HTTPException(status_code=400, detail="market_prices must be finite")
+
+    is_call = [1 if c else 0 for c in request.is_call]
+    greeks = traider_cpp.pricing.bsm_greeks_batch(
+        request.spots, request.strikes, request.times, request.volatilities,
+        is_call, request.rate, request.dividend_yields
+    )
+    # Inputs are validated above, but extreme ones can still overflow to NaN
+    response = {
+        "price": _nan_to_none(greeks.price),
+        "delta": _nan_to_none(greeks.delta),
+        "gamma": _nan_to_none(greeks.gamma),
+        "vega": _nan_to_none(greeks.vega),
+        "theta": _nan_to_none(greeks.theta),
+        "rho": _nan_to_none(greeks.rho),
+    }
+
+    if request.american:
+        response["american_price"] = _nan_to_none(traider_cpp.pricing.american_price_batch(
+            request.spots, request.strikes, request.times, request.volatilities,
+            is_call, request.rate, request.dividend_yields,
+            traider_cpp.pricing.LatticeModel.BINOMIAL, request.steps
+        ))
+
+    if request.market_prices is not None:
+        ivs = traider_cpp.pricing.implied_volatility_batch(
+            request.market_prices, request.spots, request.strikes, request.times,
+            is_call, request.rate, request.dividend_yields
+        )
+        # NaN means no solution within the no-arbitrage bounds
+        response["implied_volatility"] = _nan_to_none(ivs)
+
+    return response
+
+# --- Simulator Accounts ---
+
+# One native manager hosts every simulator account; orders are queued lock-free and
+# applied on process(), which also refreshes the incremental leaderboard.
+ACCOUNTS_AVAILABLE = CPP_AVAILABLE and hasattr(traider_cpp, "accounts")
+account_manager = traider_cpp.accounts.AccountManager() if ACCOUNTS_AVAILABLE else None
+
+class OpenAccountRequest(BaseModel):
+    user_id: str
+    initial_capital: float = 10000.0
+
+class SimOrderRequest(BaseModel):
+    user_id: str
+    ticker: str
+    quantity: float
+    side: str  # "buy" or "sell"
+    price: Optional[float] = None  # Not accepted: orders fill at the last shared price
+
+# Outcomes drained from the manager but belonging to another in-flight request of the same user
+_order_outcomes: Dict[int, object] = {}
+_order_outcomes_lock = threading.Lock()
+
+def _take_order_outcome(user_id: str, order_id: int):
+    with _order_outcomes_lock:
+        for result in account_manager.take_order_results(user_id):
+            _order_outcomes[result.order_id] = result
+        return _order_outcomes.pop(order_id, None)
+
+@app.post("/sim/accounts")
+def open_sim_account(request: OpenAccountRequest):
+    if not ACCOUNTS_AVAILABLE:
+        raise HTTPException(status_code=501, detail="C++ account engine not available")
+    if not account_manager.open_account(request.user_id, request.initial_capital):
+        raise HTTPException(status_code=409, detail="Account already exists")
+    return {"user_id": request.user_id, "initial_capital": request.initial_capital}
+
+@app.post("/sim/orders")
+def submit_sim_order(request: SimOrderRequest):
+    if not ACCOUNTS_AVAILABLE:
+        raise HTTPException(status_code=501, detail="C++ account engine not available")
+
+    side = request.side.lower()
+    if side not in ("buy", "sell"):
+        raise HTTPException(status_code=400, detail="side must be 'buy' or 'sell'")
+    order_side = traider_cpp.core.OrderSide.BUY if side == "buy" else traider_cpp.core.OrderSide.SELL
+    # Fills come from the shared mark only; a client-chosen price would let one user
+    # buy below the market and jump the leaderboard
+    if request.price is not None:
+        raise HTTPException(status_code=400, detail="Orders fill at the last shared price; omit price")
+
+    order_id = account_manager.submit_order(request.user_id, request.ticker, request.quantity, order_side)
+    if not order_id:
+        raise HTTPException(status_code=400, detail="Unknown account or order queue full")
+
+    account_manager.process()
+    outcome = _take_order_outcome(request.user_id, order_id)
+    if outcome is None or outcome.status == traider_cpp.accounts.OrderStatus.NO_PRICE:
+        raise HTTPException(status_code=409, detail="No market price for ticker yet")
+    if outcome.status == traider_cpp.accounts.OrderStatus.REJECTED:
+        raise HTTPException(status_code=400, detail="Order rejected: insufficient cash or shares")
+
+    engine = account_manager.engine_snapshot(request.user_id)
+    return {
+        "order_id": order_id,
+        "fill_price": outcome.price,
+        "capital": engine.get_capital(),
+        "portfolio_value": engine.get_portfolio_value(),
+        "rank": account_manager.rank_of(request.user_id),
+    }
+
+@app.get("/sim/leaderboard")
+def get_sim_leaderboard(limit: int = 50):
+    if not ACCOUNTS_AVAILABLE:
+        raise HTTPException(status_code=501, detail="C++ account engine not available")
+    return [
+        {
+            "rank": e.rank,
+            "name": e.user_id,
+            "score": e.score,
+            "total_return": e.total_return,
+            "sharpe_ratio": e.sharpe_ratio,
+            "portfolio_value": e.portfolio_value,
+        }
+        for e in account_manager.leaderboard(limit)
+    ]
+
+RISK_AVAILABLE = ACCOUNTS_AVAILABLE and hasattr(traider_cpp, "risk")
+
+# Return histories are cached per (holdings universe, window), so the slow fetch and
+# alignment run once however many accounts hold the same tickers. Risk engines are
+# per account on top of that: an engine's marks are shared by its portfolios, so
+# sharing one across users would let each request move the marks another user's
+# results rely on. Within an account, later requests only apply changed positions
+# and marks incrementally. Least recently used entries are dropped.
+MAX_RISK_HISTORIES = 16
+MAX_RISK_ENGINES = 256
+_risk_histories = OrderedDict()
+_risk_engines = OrderedDict()
+_risk_cache_lock = threading.Lock()
+
+class SimRiskRequest(BaseModel):
+    user_id: str
+    startDate: str
+    endDate: str
+    confidence: float = 0.99
+
+def _lru_get(cache, key):
+    # Callers hold _risk_cache_lock
+    value = cache.get(key)
+    if value is not None:
+        cache.move_to_end(key)
+    return value
+
+def _lru_put(cache, key, value, limit):
+    # Callers hold _risk_cache_lock. A concurrent insert of the same key wins.
+    value = cache.setdefault(key, value)
+    cache.move_to_end(key)
+    while len(cache) > limit:
+        cache.popitem(last=False)
+    return value
+
+def _build_risk_history(tickers, start_date_obj, end_date_obj):
+    with timed("server.sim_risk.fetch"):
+        histories = {}
+        for ticker in tickers:
+            stock_data = get_data(ticker, start_date=start_date_obj, end_date=end_date_obj, index_as_date=False)
+            if stock_data is not None and not stock_data.empty:
+                histories[ticker] = stock_data
+
+    if not histories:
+        return None
+
+    # Put every ticker on one calendar, then take close-to-close returns per column
+    names = list(histories)
+    with timed("server.sim_risk.prepare"):
+        aligned = traider_cpp.data.align_asof(
+            [(histories[t]["date"].astype("int64") // 10**9).tolist() for t in names],
+            [histories[t]["close"].tolist() for t in names],
+        )
+        rows = aligned.num_rows()
+        columns = [aligned.column(i) for i in range(len(names))]
+        valid = [aligned.valid_column(i) for i in range(len(names))]
+        # Start once every ticker has a price so no scenario mixes in a missing value
+        first = next((r for r in range(rows) if all(v[r] for v in valid)), rows)
+        returns = [
+            [col[r] / col[r - 1] - 1.0 for r in range(first + 1, rows)]
+            for col in columns
+        ]
+
+    return names, returns
+
+def _risk_engine_for(user_id, tickers, start_date_obj, end_date_obj, confidence):
+    history_key = (tuple(sorted(tickers)), start_date_obj.date(), end_date_obj.date())
+    engine_key = (user_id,) + history_key + (confidence,)
+    with _risk_cache_lock:
+        risk_engine = _lru_get(_risk_engines, engine_key)
+        if risk_engine is not None:
+            return risk_engine
+        history = _lru_get(_risk_histories, history_key)
+
+    if history is None:
+        # Fetch outside the lock; it is slow
+        history = _build_risk_history(tickers, start_date_obj, end_date_obj)
+        if history is None:
+            return None
+        with _risk_cache_lock:
+            history = _lru_put(_risk_histories, history_key, history, MAX_RISK_HISTORIES)
+
+    names, returns = history
+    risk_engine = traider_cpp.risk.RiskEngine(names, returns, confidence)
+    with _risk_cache_lock:
+        return _lru_put(_risk_engines, engine_key, risk_engine, MAX_RISK_ENGINES)
+
+@app.post("/sim/risk")
+def get_sim_risk(request: SimRiskRequest):
+    """
+    One-day VaR/CVaR of a simulator account's current holdings, by historical
+    simulation over the requested window plus a parametric (covariance) estimate.
+    """
+    if not RISK_AVAILABLE:
+        raise HTTPException(status_code=501, detail="C++ risk engine not available")
+    if not account_manager.has_account(request.user_id):
+        raise HTTPException(status_code=404, detail="Unknown account")
+    if not 0.0 < request.confidence < 1.0:
+        raise HTTPException(status_code=400, detail="confidence must be in (0, 1)")
+
+    engine = account_manager.engine_snapshot(request.user_id)
+    positions = {t: p for t, p in engine.get_positions().items() if p.quantity != 0}
+    if not positions:
+        return {"user_id": request.user_id, "var": 0.0, "cvar": 0.0, "parametric_var": 0.0,
+                "volatility": 0.0, "exposure": 0.0, "scenarios": 0, "unmapped": 0}
+
+    start_date_obj = datetime.strptime(request.startDate, "%Y-%m-%d")
+    end_date_obj = min(datetime.strptime(request.endDate, "%Y-%m-%d"), datetime.today())
+
+    risk_engine = _risk_engine_for(request.user_id, list(positions), start_date_obj, end_date_obj,
+                                   request.confidence)
+    if risk_engine is None:
+        raise HTTPException(status_code=404, detail="No price history for the account's holdings")
+
+    with timed("server.sim_risk.compute"):
+        # The engine belongs to this account alone, so moving its marks to the
+        # account's latest marks affects no one else
+        for ticker, pos in positions.items():
+            if pos.current_price > 0:
+                risk_engine.update_price(ticker, pos.current_price)
+        risk_engine.add_portfolio(request.user_id)
+        unmapped = risk_engine.sync_positions(request.user_id, engine)
+        result = risk_engine.get_risk(request.user_id)
+
+    return {
+        "user_id": request.user_id,
+        "var": result.var,
+        "cvar": result.cvar,
+        "parametric_var": result.parametric_var,
+        "volatility": result.volatility,
+        "exposure": result.exposure,
+        "scenarios": result.scenarios,
+        "unmapped": unmapped,
+    }
+
+# --- Market Replay ---
+
+REPLAY_AVAILABLE = CPP_AVAILABLE and hasattr(traider_cpp, "replay")
+
+# Driving the shared simulator accounts pushes historical prices into every real
+# account, so it needs the operator token and only one such replay may run at a time.
+REPLAY_DRIVE_TOKEN = os.getenv("TRAIDER_REPLAY_DRIVE_TOKEN")
+_driving_replay_lock = threading.Lock()
+
+@app.websocket("/replay/ws")
+async def replay_stream(
+    websocket: WebSocket,
+    tickers: str,
+    startDate: str,
+    endDate: str,
+    speed: float = 0.0,
+    drive_accounts: bool = False,
+    token: Optional[str] = None,
+):
+    """
+    Stream a native market replay over one or more comma-separated tickers.
+    The C++ clock computes indicators and reprices accounts; this handler only
+    forwards pre-serialized JSON batches. speed is sim-seconds per wall-second
+    (0 = as fast as the client reads). A slow client stalls the clock instead of
+    buffering without bound. drive_accounts requires the operator token.
+    """
+    await websocket.accept()
+    if not REPLAY_AVAILABLE:
+        await websocket.close(code=1011, reason="C++ replay engine not available")
+        return
+
+    driving = False
+    if drive_accounts:
+        if not ACCOUNTS_AVAILABLE or not REPLAY_DRIVE_TOKEN or token != REPLAY_DRIVE_TOKEN:
+            await websocket.close(code=1008, reason="drive_accounts requires the operator token")
+            return
+        if not _driving_replay_lock.acquire(blocking=False):
+            await websocket.close(code=1013, reason="Another replay is already driving the accounts")
+            return
+        driving = True
+
+    engine = traider_cpp.replay.ReplayEngine()
+    try:
+        start_date_obj = datetime.strptime(startDate, "%Y-%m-%d")
+        end_date_obj = min(datetime.strptime(endDate, "%Y-%m-%d"), datetime.today())
+
+        for ticker in [t.strip() for t in tickers.split(",") if t.strip()]:
+            stock_data = await asyncio.to_thread(
+                get_data, ticker, start_date=start_date_obj, end_date=end_date_obj, index_as_date=False
+            )
+            if stock_data is None or stock_data.empty:
+                continue
+            engine.add_series_arrays(
+                ticker,
+                (stock_data["date"].astype("int64") // 10**9).tolist(),
+                stock_data["open"].tolist(),
+                stock_data["high"].tolist(),
+                stock_data["low"].tolist(),
+                stock_data["close"].tolist(),
+                stock_data["volume"].astype(float).tolist(),
+            )
+
+        if driving:
+            engine.attach_accounts(account_manager)
+
+        engine.set_speed(speed)
+        engine.start()
+
+        while True:
+            # Sample completion before polling: the final batch is pushed before
+            # finished is set, so an empty poll after a positive check is really the end
+            done = engine.finished() or not engine.running()
+            batch = engine.poll_json(512)
+            if batch != "[]":
+                await websocket.send_text(batch)
+            elif done:
+                break
+            else:
+                await asyncio.sleep(0.01)
+
+        await websocket.send_text(json.dumps([{"type": "done", "timestamp": engine.current_time()}]))
+        await websocket.close()
+    except WebSocketDisconnect:
+        pass
+    except Exception as e:
+        print(f"Error in replay stream: {e}")
+        await websocket.close(code=1011)
+    finally:
+        engine.stop()
+        if driving:
+            _driving_replay_lock.release()
+
+# --- Metrics Endpoints ---
+
+class MetricsToggleRequest(BaseModel):
+    enabled: bool
+
+@app.get("/metrics")
+def get_metrics():
+    """
+    Per-probe call counts, bytes processed and latency percentiles from the C++ instrumentation layer.
+    Probes prefixed with "server." are Python-side stages (data fetch, list conversion).
+    """
+    if not METRICS_AVAILABLE:
+        raise HTTPException(status_code=501, detail="C++ metrics not available")
+
+    return {
+        "enabled": traider_cpp.metrics.is_enabled(),
+        "probes": [
+            {
+                "name": p.name,
+                "calls": p.calls,
+                "bytes": p.bytes,
+                "mean_ns": p.mean_ns,
+                "p50_ns": p.p50_ns,
+                "p99_ns": p.p99_ns,
+                "p999_ns": p.p999_ns,
+                "max_ns": p.max_ns,
+            }
+            for p in traider_cpp.metrics.snapshot()
+        ],
+    }
+
+@app.post("/metrics/reset")
+def reset_metrics():
+    if not METRICS_AVAILABLE:
+        raise HTTPException(status_code=501, detail="C++ metrics not available")
+    traider_cpp.metrics.reset()
+    return {"status": "ok"}
+
+@app.post("/metrics/enable")
+def toggle_metrics(request: MetricsToggleRequest):
+    if not METRICS_AVAILABLE:
+        raise HTTPException(status_code=501, detail="C++ metrics not available")
+    if request.enabled:
+        traider_cpp.metrics.enable()
+    else:
+        traider_cpp.metrics.disable()
+    return {"enabled": traider_cpp.metrics.is_enabled()}